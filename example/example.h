@@ -20,6 +20,7 @@
 #include <fit/compress.hpp>
 #include <fit/conditional.hpp>
 #include <fit/construct.hpp>
+#include <fit/contains.hpp>
 #include <fit/decay.hpp>
 #include <fit/decorate.hpp>
 #include <fit/eval.hpp>
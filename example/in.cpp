@@ -9,41 +9,6 @@
 
 using namespace fit;
 
-#ifdef _MSC_VER
-template<class R, class T>
-auto member_find(const R& r, const T& x) FIT_RETURNS(r.find(x));
-#endif
-
-// Function to find an iterator using a containers built-in find if available
-FIT_STATIC_LAMBDA_FUNCTION(find_iterator) = conditional(
-    [](const std::string& s, const auto& x)
-    {
-        auto index = s.find(x);
-        if (index == std::string::npos) return s.end();
-        else return s.begin() + index;
-    },
-#ifdef _MSC_VER
-    // On MSVC, trailing decltype doesn't work with generic lambdas, so a
-    // seperate function can be used instead.
-    FIT_LIFT(member_find),
-#else
-    [](const auto& r, const auto& x) FIT_RETURNS(r.find(x)),
-#endif
-    [](const auto& r, const auto& x)
-    {
-        using std::begin;
-        using std::end;
-        return std::find(begin(r), end(r), x);
-    }
-);
-// Implement an infix `in` operator to check if a range contains an element
-FIT_STATIC_LAMBDA_FUNCTION(in) = infix(
-    [](const auto& x, const auto& r)
-    {
-        using std::end;
-        return find_iterator(r, x) != end(r);
-    }
-);
 // Negate version of `in`
 FIT_STATIC_LAMBDA_FUNCTION(not_in) = infix(compose(not _, in));
 
@@ -67,6 +32,12 @@ int main()
 
     if (4 <in> number_map) std::cout << "Yes" << std::endl;
 
+    // Check a sorted vector with a binary search
+    if (3 <in> sorted(numbers)) std::cout << "Yes" << std::endl;
+
+    // Check a set of values known at compile time
+    if (numbers[0] <in> value_set<1, 5, 9>()) std::cout << "Yes" << std::endl;
+
     // Check if map doesn't contains element
     if (not (8 <in> numbers)) std::cout << "No" << std::endl;
     if (8 <not_in> numbers) std::cout << "No" << std::endl;
@@ -10,6 +10,8 @@
 
 #include <fit/alias.hpp>
 #include <fit/always.hpp>
+#include <fit/and_then_flow.hpp>
+#include <fit/any_of.hpp>
 #include <fit/apply_eval.hpp>
 #include <fit/apply.hpp>
 #include <fit/arg.hpp>
@@ -18,15 +20,24 @@
 #include <fit/combine.hpp>
 #include <fit/compose.hpp>
 #include <fit/compress.hpp>
+#include <fit/compress_until.hpp>
 #include <fit/conditional.hpp>
 #include <fit/construct.hpp>
+#include <fit/contains.hpp>
+#include <fit/cpu_dispatch.hpp>
 #include <fit/decay.hpp>
+#include <fit/decay_borrow.hpp>
 #include <fit/decorate.hpp>
+#include <fit/devirtualize.hpp>
 #include <fit/eval.hpp>
+#include <fit/filter.hpp>
 #include <fit/fix.hpp>
+#include <fit/fix_parallel.hpp>
+#include <fit/fix_stackless.hpp>
 #include <fit/flip.hpp>
 #include <fit/flow.hpp>
 #include <fit/function.hpp>
+#include <fit/hash_fields.hpp>
 #include <fit/identity.hpp>
 #include <fit/if.hpp>
 #include <fit/implicit.hpp>
@@ -38,7 +49,9 @@
 #include <fit/lift.hpp>
 #include <fit/limit.hpp>
 #include <fit/match.hpp>
+#include <fit/member.hpp>
 #include <fit/mutable.hpp>
+#include <fit/once.hpp>
 #include <fit/pack.hpp>
 #include <fit/partial.hpp>
 #include <fit/pipable.hpp>
@@ -51,7 +64,12 @@
 #include <fit/reveal.hpp>
 #include <fit/reverse_compress.hpp>
 #include <fit/rotate.hpp>
+#include <fit/scan.hpp>
+#include <fit/serialize.hpp>
+#include <fit/share.hpp>
 #include <fit/static.hpp>
+#include <fit/stream.hpp>
+#include <fit/string_switch.hpp>
 #include <fit/tap.hpp>
 #include <fit/unpack.hpp>
 
@@ -9,6 +9,8 @@
 #define FIT_GUARD_FUNCTION_ALWAYS_H
 
 #include <fit/detail/unwrap.hpp>
+#include <fit/detail/intrinsics.hpp>
+#include <fit/detail/relaxed_constexpr.hpp>
 #include <fit/detail/static_const_var.hpp>
 
 /// always
@@ -24,6 +26,12 @@
 /// `void`, a private empty type is returned instead. This return type is
 /// specified as `FIT_ALWAYS_VOID_RETURN`.
 /// 
+/// Small trivially copyable values are returned by value. Other values are
+/// returned by const reference when the function object is called as an
+/// lvalue, and moved out when it is called as an rvalue, so the value is not
+/// copied on every call. The `always_copy` function always returns a copy of
+/// the value instead.
+/// 
 /// Synopsis
 /// --------
 /// 
@@ -33,6 +41,9 @@
 ///     template<class T>
 ///     constexpr auto always(void);
 /// 
+///     template<class T>
+///     constexpr auto always_copy(T value);
+/// 
 /// 
 /// Semantics
 /// ---------
@@ -44,6 +55,10 @@
 /// 
 /// T must be:
 /// 
+/// * MoveConstructible
+/// 
+/// For `always_copy`, T must be:
+/// 
 /// * CopyConstructible
 /// 
 /// Example
@@ -78,15 +93,34 @@
 
 namespace fit { namespace always_detail {
 
+// Small trivially copyable values are returned by value, everything else is
+// returned by reference or moved out
+template<class T>
+struct always_by_value
+: std::integral_constant<bool, (
+    FIT_IS_TRIVIALLY_COPYABLE(T) && sizeof(T) <= 2*sizeof(void*)
+)>
+{};
+
+template<class T>
+struct always_by_value<T&>
+: std::true_type
+{};
+
+template<>
+struct always_by_value<void>
+: std::true_type
+{};
+
 template<class T>
-struct always_base
+struct always_copy_base
 {
     T x;
     
-    constexpr always_base()
+    constexpr always_copy_base()
     {}
     
-    constexpr always_base(T xp) : x(xp)
+    constexpr always_copy_base(T xp) : x(static_cast<T&&>(xp))
     {}
 
     template<class... As>
@@ -97,6 +131,42 @@ struct always_base
     }
 };
 
+template<class T, bool=always_by_value<T>::value>
+struct always_base : always_copy_base<T>
+{
+    constexpr always_base()
+    {}
+    
+    constexpr always_base(T xp) : always_copy_base<T>(static_cast<T&&>(xp))
+    {}
+};
+
+template<class T>
+struct always_base<T, false>
+{
+    T x;
+    
+    constexpr always_base()
+    {}
+    
+    constexpr always_base(T xp) : x(static_cast<T&&>(xp))
+    {}
+
+    template<class... As>
+    constexpr const T& 
+    operator()(As&&...) const&
+    {
+        return this->x;
+    }
+
+    template<class... As>
+    FIT_RELAXED_CONSTEXPR T
+    operator()(As&&...) &&
+    {
+        return static_cast<T&&>(this->x);
+    }
+};
+
 #if FIT_NO_CONSTEXPR_VOID
 #define FIT_ALWAYS_VOID_RETURN fit::always_detail::always_base<void>::void_
 #else
@@ -104,7 +174,7 @@ struct always_base
 #endif
 
 template<>
-struct always_base<void>
+struct always_base<void, true>
 {
     
     constexpr always_base()
@@ -127,7 +197,7 @@ struct always_f
     template<class T>
     constexpr always_detail::always_base<T> operator()(T x) const
     {
-        return always_detail::always_base<T>(x);
+        return always_detail::always_base<T>(static_cast<T&&>(x));
     }
 
     constexpr always_detail::always_base<void> operator()() const
@@ -136,6 +206,15 @@ struct always_f
     }
 };
 
+struct always_copy_f
+{
+    template<class T>
+    constexpr always_detail::always_copy_base<T> operator()(T x) const
+    {
+        return always_detail::always_copy_base<T>(static_cast<T&&>(x));
+    }
+};
+
 struct always_ref_f
 {
     template<class T>
@@ -147,6 +226,7 @@ struct always_ref_f
 
 }
 FIT_DECLARE_STATIC_VAR(always, always_detail::always_f);
+FIT_DECLARE_STATIC_VAR(always_copy, always_detail::always_copy_f);
 FIT_DECLARE_STATIC_VAR(always_ref, always_detail::always_ref_f);
 
 } // namespace fit
@@ -0,0 +1,256 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    and_then_flow.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_AND_THEN_FLOW_H
+#define FIT_GUARD_FUNCTION_AND_THEN_FLOW_H
+
+/// and_then_flow
+/// =============
+///
+/// Description
+/// -----------
+///
+/// The `and_then_flow` function adaptor works like `flow`, except that each
+/// function returns an optional-like or expected-like value. The result is
+/// checked before calling the next function, and if it is empty or holds an
+/// error, the remaining functions are skipped and the failure is returned.
+/// Otherwise, the next function is called with the unwrapped value(ie
+/// `*r`). No exceptions are used, and each stage is just a branch.
+///
+/// A failed result is converted to the result type of the last function
+/// using `and_then_failure`. By default, a result of the same type is
+/// returned as is, a result with an `error()` is converted through the
+/// `unexpected_type` of the final result type(if it has one), and
+/// otherwise an empty(ie default constructed) result is returned when the
+/// final result type is optional-like. Any other failure, such as an empty
+/// optional that fails into an expected-like result, doesn't compile,
+/// since a default constructed expected would be a success. This can be
+/// customized by specializing `and_then_failure`.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Fs>
+///     constexpr and_then_flow_adaptor<Fs...> and_then_flow(Fs... fs);
+///
+///     template<class R, class=void>
+///     struct and_then_failure
+///     {
+///         template<class X>
+///         static constexpr R apply(X&& failed);
+///     };
+///
+/// Semantics
+/// ---------
+///
+///     assert(and_then_flow(f)(xs...) == f(xs...));
+///     assert(and_then_flow(f, g)(xs...) == (f(xs...) ? g(*f(xs...)) : and_then_failure<R>::apply(f(xs...))));
+///
+/// Requirements
+/// ------------
+///
+/// Fs must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// The result of every function but the last must be contextually
+/// convertible to `bool` and be dereferenceable.
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///
+///     struct lookup
+///     {
+///         const int * operator()(int i) const
+///         {
+///             static const int table[] = { 1, 2, 3 };
+///             return (i >= 0 && i < 3) ? table + i : nullptr;
+///         }
+///     };
+///
+///     int main() {
+///         auto f = fit::and_then_flow(lookup(), lookup());
+///         assert(*f(0) == 2);
+///         assert(f(2) == nullptr);
+///         assert(f(5) == nullptr);
+///     }
+///
+
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/compressed_pair.hpp>
+#include <fit/detail/join.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/detail/make.hpp>
+#include <fit/detail/static_const_var.hpp>
+
+namespace fit { namespace detail {
+
+template<class R, class=void>
+struct has_unexpected_type
+: std::false_type
+{};
+
+template<class R>
+struct has_unexpected_type<R, typename holder<
+    typename R::unexpected_type
+>::type>
+: std::true_type
+{};
+
+template<class X, class=void>
+struct has_error
+: std::false_type
+{};
+
+template<class X>
+struct has_error<X, typename holder<
+    decltype(std::declval<X>().error())
+>::type>
+: std::true_type
+{};
+
+// Converts to bool, and has no error, so a default constructed value is
+// empty
+template<class R>
+struct and_then_is_optional
+: std::integral_constant<bool, (
+    std::is_constructible<bool, R>::value && !has_error<R>::value && !has_unexpected_type<R>::value
+)>
+{};
+
+template<class R, class X, typename std::enable_if<(
+    std::is_same<R, typename std::decay<X>::type>::value
+), int>::type = 0>
+constexpr R and_then_fail(X&& x)
+{
+    return FIT_FORWARD(X)(x);
+}
+
+template<class R, class X, typename std::enable_if<(
+    !std::is_same<R, typename std::decay<X>::type>::value &&
+    has_unexpected_type<R>::value && has_error<X>::value
+), int>::type = 0>
+constexpr R and_then_fail(X&& x)
+{
+    return R(typename R::unexpected_type(FIT_FORWARD(X)(x).error()));
+}
+
+template<class R, class X, typename std::enable_if<(
+    !std::is_same<R, typename std::decay<X>::type>::value &&
+    !(has_unexpected_type<R>::value && has_error<X>::value)
+), int>::type = 0>
+constexpr R and_then_fail(X&&)
+{
+    static_assert(and_then_is_optional<R>::value, "The failure can't be converted to the result, so and_then_failure must be specialized for it");
+    return R();
+}
+
+}
+
+template<class R, class=void>
+struct and_then_failure
+{
+    template<class X>
+    static constexpr R apply(X&& x)
+    {
+        return detail::and_then_fail<R>(FIT_FORWARD(X)(x));
+    }
+};
+
+namespace detail {
+
+struct and_then_bind_f
+{
+    template<class G, class X, class Result=typename std::decay<
+        decltype(std::declval<G>()(*std::declval<X>()))
+    >::type>
+    constexpr Result operator()(G&& g, X&& x) const
+    {
+        return x ? g(*FIT_FORWARD(X)(x)) : and_then_failure<Result>::apply(FIT_FORWARD(X)(x));
+    }
+};
+
+template<class F1, class F2>
+struct and_then_flow_kernel : detail::compressed_pair<detail::callable_base<F1>, detail::callable_base<F2>>
+{
+    typedef detail::compressed_pair<detail::callable_base<F1>, detail::callable_base<F2>> base_type;
+
+    FIT_INHERIT_CONSTRUCTOR(and_then_flow_kernel, base_type)
+
+    FIT_RETURNS_CLASS(and_then_flow_kernel);
+
+    template<class... Ts>
+    constexpr FIT_SFINAE_RESULT(and_then_bind_f, id_<const detail::callable_base<F2>&>, result_of<const detail::callable_base<F1>&, id_<Ts>...>)
+    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        and_then_bind_f()(
+            FIT_MANGLE_CAST(const detail::callable_base<F2>&)(FIT_CONST_THIS->second(xs...)),
+            FIT_MANGLE_CAST(const detail::callable_base<F1>&)(FIT_CONST_THIS->first(xs...))(FIT_FORWARD(Ts)(xs)...)
+        )
+    );
+};
+}
+
+template<class F, class... Fs>
+struct and_then_flow_adaptor : detail::and_then_flow_kernel<F, FIT_JOIN(and_then_flow_adaptor, Fs...)>
+{
+    typedef and_then_flow_adaptor fit_rewritable_tag;
+    typedef FIT_JOIN(and_then_flow_adaptor, Fs...) tail;
+    typedef detail::and_then_flow_kernel<F, tail> base_type;
+
+    FIT_INHERIT_DEFAULT(and_then_flow_adaptor, base_type)
+
+    template<class X, class... Xs,
+        FIT_ENABLE_IF_CONSTRUCTIBLE(detail::callable_base<F>, X),
+        FIT_ENABLE_IF_CONSTRUCTIBLE(tail, Xs...)
+    >
+    constexpr and_then_flow_adaptor(X&& f1, Xs&& ... fs)
+    : base_type(FIT_FORWARD(X)(f1), tail(FIT_FORWARD(Xs)(fs)...))
+    {}
+
+    template<class X,
+        FIT_ENABLE_IF_CONSTRUCTIBLE(detail::callable_base<F>, X)
+    >
+    constexpr and_then_flow_adaptor(X&& f1)
+    : base_type(FIT_FORWARD(X)(f1))
+    {}
+};
+
+template<class F>
+struct and_then_flow_adaptor<F> : detail::callable_base<F>
+{
+    typedef and_then_flow_adaptor fit_rewritable_tag;
+    FIT_INHERIT_DEFAULT(and_then_flow_adaptor, detail::callable_base<F>)
+
+    template<class X, FIT_ENABLE_IF_CONVERTIBLE(X, detail::callable_base<F>)>
+    constexpr and_then_flow_adaptor(X&& f1)
+    : detail::callable_base<F>(FIT_FORWARD(X)(f1))
+    {}
+
+};
+
+template<class F1, class F2>
+struct and_then_flow_adaptor<F1, F2>
+: detail::and_then_flow_kernel<detail::callable_base<F1>, detail::callable_base<F2>>
+{
+    typedef and_then_flow_adaptor fit_rewritable_tag;
+    typedef detail::and_then_flow_kernel<detail::callable_base<F1>, detail::callable_base<F2>> base_type;
+
+    FIT_INHERIT_CONSTRUCTOR(and_then_flow_adaptor, base_type)
+};
+
+FIT_DECLARE_STATIC_VAR(and_then_flow, detail::make<and_then_flow_adaptor>);
+
+} // namespace fit
+
+#endif
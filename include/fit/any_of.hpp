@@ -0,0 +1,198 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    any_of.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_ANY_OF_H
+#define FIT_GUARD_ANY_OF_H
+
+/// any_of
+/// ======
+///
+/// Description
+/// -----------
+///
+/// The `any_of`, `all_of` and `find_if` function adaptors call a unary
+/// predicate on each argument, from left to right, and stop as soon as the
+/// result is known. `any_of` stops on the first argument that satisfies the
+/// predicate, and `all_of` stops on the first argument that doesn't.
+/// `find_if` returns the index of the first argument that satisfies the
+/// predicate, or the number of arguments if none of them do.
+///
+/// The arguments after the stopping point are never used. When used with
+/// [`by`](/include/fit/by), they aren't projected either, and with
+/// [`unpack`](/include/fit/unpack) they can be the elements of a sequence.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Predicate>
+///     constexpr any_of_adaptor<Predicate> any_of(Predicate p);
+///
+///     template<class Predicate>
+///     constexpr all_of_adaptor<Predicate> all_of(Predicate p);
+///
+///     template<class Predicate>
+///     constexpr find_if_adaptor<Predicate> find_if(Predicate p);
+///
+/// Semantics
+/// ---------
+///
+///     assert(any_of(p)(xs...) == (false || ... || p(xs)));
+///     assert(all_of(p)(xs...) == (true && ... && p(xs)));
+///     assert(find_if(p)() == 0);
+///     assert(find_if(p)(x, xs...) == (p(x) ? 0 : 1 + find_if(p)(xs...)));
+///
+/// Requirements
+/// ------------
+///
+/// Predicate must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <tuple>
+///
+///     struct is_negative
+///     {
+///         template<class T>
+///         constexpr bool operator()(T x) const
+///         {
+///             return x < 0;
+///         }
+///     };
+///
+///     int main() {
+///         assert(fit::any_of(is_negative())(1, -2.0, 3));
+///         assert(!fit::all_of(is_negative())(1, -2.0, 3));
+///         assert(fit::unpack(fit::find_if(is_negative()))(std::make_tuple(1, -2.0, 3)) == 1);
+///     }
+///
+
+#include <fit/always.hpp>
+#include <fit/is_callable.hpp>
+#include <fit/detail/and.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/lazy_arg.hpp>
+#include <fit/detail/make.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+
+namespace fit {
+
+namespace detail {
+
+struct any_of_fold
+{
+    typedef bool result_type;
+
+    template<class P>
+    constexpr bool operator()(const P&) const
+    {
+        return false;
+    }
+
+    template<class P, class T, class... Ts>
+    constexpr bool operator()(const P& p, T&& x, Ts&&... xs) const
+    {
+        return p(detail::lazy_arg_get(FIT_FORWARD(T)(x))) || (*this)(p, FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+struct all_of_fold
+{
+    typedef bool result_type;
+
+    template<class P>
+    constexpr bool operator()(const P&) const
+    {
+        return true;
+    }
+
+    template<class P, class T, class... Ts>
+    constexpr bool operator()(const P& p, T&& x, Ts&&... xs) const
+    {
+        return p(detail::lazy_arg_get(FIT_FORWARD(T)(x))) && (*this)(p, FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+template<std::size_t I=0>
+struct find_if_fold
+{
+    typedef std::size_t result_type;
+
+    template<class P>
+    constexpr std::size_t operator()(const P&) const
+    {
+        return I;
+    }
+
+    template<class P, class T, class... Ts>
+    constexpr std::size_t operator()(const P& p, T&& x, Ts&&... xs) const
+    {
+        return p(detail::lazy_arg_get(FIT_FORWARD(T)(x))) ? I : find_if_fold<I+1>()(p, FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+template<class Fold, class P>
+struct short_circuit_base : detail::callable_base<P>
+{
+    FIT_INHERIT_CONSTRUCTOR(short_circuit_base, detail::callable_base<P>);
+
+    template<class... Ts>
+    constexpr const detail::callable_base<P>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Ts, class=typename std::enable_if<(
+        and_<is_callable<const detail::callable_base<P>&, typename lazy_arg_result<Ts&&>::type>...>::value
+    )>::type>
+    constexpr typename Fold::result_type operator()(Ts&&... xs) const
+    {
+        return Fold()(this->base_function(xs...), FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+}
+
+template<class P>
+struct any_of_adaptor : detail::short_circuit_base<detail::any_of_fold, P>
+{
+    typedef any_of_adaptor fit_lazy_args_tag;
+    typedef detail::short_circuit_base<detail::any_of_fold, P> base;
+    FIT_INHERIT_CONSTRUCTOR(any_of_adaptor, base);
+};
+
+template<class P>
+struct all_of_adaptor : detail::short_circuit_base<detail::all_of_fold, P>
+{
+    typedef all_of_adaptor fit_lazy_args_tag;
+    typedef detail::short_circuit_base<detail::all_of_fold, P> base;
+    FIT_INHERIT_CONSTRUCTOR(all_of_adaptor, base);
+};
+
+template<class P>
+struct find_if_adaptor : detail::short_circuit_base<detail::find_if_fold<>, P>
+{
+    typedef find_if_adaptor fit_lazy_args_tag;
+    typedef detail::short_circuit_base<detail::find_if_fold<>, P> base;
+    FIT_INHERIT_CONSTRUCTOR(find_if_adaptor, base);
+};
+
+FIT_DECLARE_STATIC_VAR(any_of, detail::make<any_of_adaptor>);
+FIT_DECLARE_STATIC_VAR(all_of, detail::make<all_of_adaptor>);
+FIT_DECLARE_STATIC_VAR(find_if, detail::make<find_if_adaptor>);
+
+} // namespace fit
+
+#endif
@@ -23,6 +23,9 @@
 /// for each of its arguments.
 /// 
 /// Note: All projections are always evaluated in order from left-to-right.
+/// When the function can stop early, such as [`any_of`](/include/fit/any_of)
+/// or [`compress_until`](/include/fit/compress_until), each projection is
+/// only evaluated when the function uses that argument.
 /// 
 /// Synopsis
 /// --------
@@ -81,6 +84,7 @@
 #include <fit/detail/make.hpp>
 #include <fit/detail/static_const_var.hpp>
 #include <fit/detail/compressed_pair.hpp>
+#include <fit/detail/lazy_arg.hpp>
 #include <fit/apply_eval.hpp>
 
 namespace fit {
@@ -134,12 +138,22 @@ constexpr project_void_eval<T, Projection> make_project_void_eval(T&& x, const P
 template<class Projection, class F, class... Ts, 
     class R=decltype(
         std::declval<const F&>()(std::declval<const Projection&>()(std::declval<Ts>())...)
-    )>
+    ), typename std::enable_if<(!has_lazy_args<F>::value), int>::type = 0>
 constexpr R by_eval(const Projection& p, const F& f, Ts&&... xs)
 {
     return fit::apply_eval(f, make_project_eval(FIT_FORWARD(Ts)(xs), p)...);
 }
 
+// The function can stop early, so only the arguments it uses are projected
+template<class Projection, class F, class... Ts, 
+    class R=decltype(
+        std::declval<const F&>()(std::declval<const Projection&>()(std::declval<Ts>())...)
+    ), typename std::enable_if<(has_lazy_args<F>::value), int>::type = 0>
+constexpr R by_eval(const Projection& p, const F& f, Ts&&... xs)
+{
+    return f(detail::make_lazy_arg(make_project_eval(FIT_FORWARD(Ts)(xs), p))...);
+}
+
 #if FIT_NO_ORDERED_BRACE_INIT
 #define FIT_BY_VOID_RETURN FIT_ALWAYS_VOID_RETURN
 #else
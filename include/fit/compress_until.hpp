@@ -0,0 +1,188 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    compress_until.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_COMPRESS_UNTIL_H
+#define FIT_GUARD_COMPRESS_UNTIL_H
+
+/// compress_until
+/// ==============
+///
+/// Description
+/// -----------
+///
+/// The `compress_until` function adaptor folds the arguments like
+/// [`compress`](/include/fit/compress), but before each step it calls the
+/// predicate on the state. As soon as the predicate is true, the state is
+/// returned and the rest of the arguments are not used. When used with
+/// [`by`](/include/fit/by), they aren't projected either.
+///
+/// The state always has the type of the initial state, so the binary
+/// function must return something convertible to it.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Predicate, class F, class State>
+///     constexpr compress_until_adaptor<Predicate, F, State> compress_until(Predicate p, F f, State s);
+///
+/// Semantics
+/// ---------
+///
+///     assert(compress_until(p, f, z)() == z);
+///     assert(compress_until(p, f, z)(x, xs...) == (p(z) ? z : compress_until(p, f, f(z, x))(xs...)));
+///
+/// Requirements
+/// ------------
+///
+/// Predicate must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// F must be:
+///
+/// * [BinaryCallable](BinaryCallable)
+/// * MoveConstructible
+///
+/// State must be:
+///
+/// * CopyConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <utility>
+///
+///     struct not_equal
+///     {
+///         constexpr bool operator()(int c) const
+///         {
+///             return c != 0;
+///         }
+///     };
+///
+///     struct compare_field
+///     {
+///         template<class T>
+///         constexpr int operator()(int, const T& p) const
+///         {
+///             return p.first < p.second ? -1 : (p.second < p.first ? 1 : 0);
+///         }
+///     };
+///
+///     int main() {
+///         auto lexicographic = fit::compress_until(not_equal(), compare_field(), 0);
+///         assert(lexicographic(std::make_pair(1, 1), std::make_pair(1, 2), std::make_pair(3, 0)) == -1);
+///     }
+///
+
+#include <fit/always.hpp>
+#include <fit/is_callable.hpp>
+#include <fit/detail/and.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/compressed_pair.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/lazy_arg.hpp>
+#include <fit/detail/make.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/detail/static_const_var.hpp>
+
+namespace fit {
+
+namespace detail {
+
+template<class State>
+struct until_fold
+{
+    template<class P, class F>
+    constexpr State operator()(const P&, const F&, State state) const
+    {
+        return state;
+    }
+
+    template<class P, class F, class T, class... Ts>
+    constexpr State operator()(const P& p, const F& f, State state, T&& x, Ts&&... xs) const
+    {
+        return p(static_cast<const State&>(state)) ?
+            fit::move(state) :
+            (*this)(p, f, static_cast<State>(f(fit::move(state), detail::lazy_arg_get(FIT_FORWARD(T)(x)))), FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+template<class F, class State, class T, class=void>
+struct until_step_is_callable
+: std::false_type
+{};
+
+template<class F, class State, class T>
+struct until_step_is_callable<F, State, T, typename holder<
+    decltype(std::declval<F>()(std::declval<State>(), std::declval<T>()))
+>::type>
+: std::is_convertible<decltype(std::declval<F>()(std::declval<State>(), std::declval<T>())), State>
+{};
+
+}
+
+template<class P, class F, class State>
+struct compress_until_adaptor
+: detail::compressed_pair<detail::compressed_pair<detail::callable_base<P>, detail::callable_base<F>>, State>
+{
+    typedef compress_until_adaptor fit_lazy_args_tag;
+    typedef detail::compressed_pair<detail::callable_base<P>, detail::callable_base<F>> functions_type;
+    typedef detail::compressed_pair<functions_type, State> base_type;
+
+    template<class X, class Y, class Z>
+    constexpr compress_until_adaptor(X&& p, Y&& f, Z&& s)
+    : base_type(functions_type(FIT_FORWARD(X)(p), FIT_FORWARD(Y)(f)), FIT_FORWARD(Z)(s))
+    {}
+
+    FIT_INHERIT_DEFAULT(compress_until_adaptor, base_type)
+
+    template<class... Ts>
+    constexpr const detail::callable_base<P>& base_predicate(Ts&&... xs) const
+    {
+        return this->first(xs...).first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...).second(xs...);
+    }
+
+    template<class... Ts>
+    constexpr State get_state(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+    template<class... Ts, class=typename std::enable_if<(
+        is_callable<const detail::callable_base<P>&, const State&>::value &&
+        detail::and_<detail::until_step_is_callable<
+            const detail::callable_base<F>&, State, typename detail::lazy_arg_result<Ts&&>::type
+        >...>::value
+    )>::type>
+    constexpr State operator()(Ts&&... xs) const
+    {
+        return detail::until_fold<State>()(
+            this->base_predicate(xs...),
+            this->base_function(xs...),
+            this->get_state(xs...),
+            FIT_FORWARD(Ts)(xs)...
+        );
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(compress_until, detail::make<compress_until_adaptor>);
+
+} // namespace fit
+
+#endif
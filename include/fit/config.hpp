@@ -10,6 +10,12 @@
 
 
 // Check for std version
+#if __cplusplus >= 201703
+#define FIT_HAS_STD_17 1
+#else
+#define FIT_HAS_STD_17 0
+#endif
+
 #if __cplusplus >= 201402
 #define FIT_HAS_STD_14 1
 #else
@@ -88,6 +94,92 @@
 #endif
 #endif
 
+// Whether lambdas can be used in constant expressions
+#ifndef FIT_HAS_CONSTEXPR_LAMBDA
+#if defined(__cpp_constexpr) && __cpp_constexpr >= 201603
+#define FIT_HAS_CONSTEXPR_LAMBDA 1
+#else
+#define FIT_HAS_CONSTEXPR_LAMBDA 0
+#endif
+#endif
+
+// Whether lambdas without captures are default constructible
+#ifndef FIT_HAS_DEFAULT_CONSTRUCTIBLE_LAMBDA
+#if __cplusplus > 201703
+#define FIT_HAS_DEFAULT_CONSTRUCTIBLE_LAMBDA 1
+#else
+#define FIT_HAS_DEFAULT_CONSTRUCTIBLE_LAMBDA 0
+#endif
+#endif
+
+// Whether the compiler supports inline variables
+#ifndef FIT_HAS_INLINE_VARIABLES
+#if defined(__cpp_inline_variables)
+#define FIT_HAS_INLINE_VARIABLES 1
+#else
+#define FIT_HAS_INLINE_VARIABLES FIT_HAS_STD_17
+#endif
+#endif
+
+// Whether non-type template parameters can be declared with auto
+#ifndef FIT_HAS_TEMPLATE_AUTO
+#if defined(__cpp_nontype_template_parameter_auto)
+#define FIT_HAS_TEMPLATE_AUTO 1
+#else
+#define FIT_HAS_TEMPLATE_AUTO FIT_HAS_STD_17
+#endif
+#endif
+
+// Whether the compiler can tell if a type has no padding bits
+#ifndef FIT_HAS_UNIQUE_OBJECT_REPRESENTATIONS
+#if (defined(__GNUC__) && !defined (__clang__) && __GNUC__ >= 7) || (defined(__clang__) && __clang_major__ >= 6) || (defined(_MSC_VER) && _MSC_VER >= 1911)
+#define FIT_HAS_UNIQUE_OBJECT_REPRESENTATIONS 1
+#else
+#define FIT_HAS_UNIQUE_OBJECT_REPRESENTATIONS 0
+#endif
+#endif
+
+// Whether the standard library has std::string_view
+#ifndef FIT_HAS_STRING_VIEW
+#if defined(__has_include) && __cplusplus >= 201703L
+#if __has_include(<string_view>)
+#define FIT_HAS_STRING_VIEW 1
+#else
+#define FIT_HAS_STRING_VIEW 0
+#endif
+#else
+#define FIT_HAS_STRING_VIEW 0
+#endif
+#endif
+
+// Whether the code is built with AddressSanitizer
+#ifndef FIT_HAS_ADDRESS_SANITIZER
+#if defined(__SANITIZE_ADDRESS__)
+#define FIT_HAS_ADDRESS_SANITIZER 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define FIT_HAS_ADDRESS_SANITIZER 1
+#else
+#define FIT_HAS_ADDRESS_SANITIZER 0
+#endif
+#else
+#define FIT_HAS_ADDRESS_SANITIZER 0
+#endif
+#endif
+
+// Whether the compiler supports coroutines
+#ifndef FIT_HAS_COROUTINES
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902 && defined(__has_include)
+#if __has_include(<coroutine>)
+#define FIT_HAS_COROUTINES 1
+#else
+#define FIT_HAS_COROUTINES 0
+#endif
+#else
+#define FIT_HAS_COROUTINES 0
+#endif
+#endif
+
 // Whether a constexpr function can use a void return type
 #ifndef FIT_NO_CONSTEXPR_VOID
 #if FIT_HAS_RELAXED_CONSTEXPR
@@ -153,4 +245,10 @@
 #endif
 #endif
 
+// Whether the library can assume it is only used from a single thread, which
+// allows it to use plain integers instead of atomics for reference counts.
+#ifndef FIT_SINGLE_THREADED
+#define FIT_SINGLE_THREADED 0
+#endif
+
 #endif
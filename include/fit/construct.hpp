@@ -19,6 +19,13 @@
 /// the parameters to the template. The `construct_meta` can be used to
 /// construct the object from a metafunction.
 /// 
+/// The `from` member of `construct<T>()` builds a container from each of its
+/// arguments instead. It reserves space for all of them when the container
+/// has `reserve`, and then uses `emplace_back` with each argument forwarded,
+/// so rvalues are moved into the container. Unlike an `initializer_list`,
+/// the elements are never copied. It can be passed to `unpack` to turn a
+/// tuple into a container.
+/// 
 /// Synopsis
 /// --------
 /// 
@@ -41,6 +48,7 @@
 ///     assert(construct<Template>()(xs...) == Template<decltype(xs)...>(xs...));
 ///     assert(construct_meta<MetafunctionClass>()(xs...) == MetafunctionClass::apply<decltype(xs)...>(xs...));
 ///     assert(construct_meta<MetafunctionTemplate>()(xs...) == MetafunctionTemplate<decltype(xs)...>::type(xs...));
+///     assert(construct<T>().from(xs...) == T{xs...});
 /// 
 /// Requirements
 /// ------------
@@ -58,6 +66,11 @@
 /// 
 /// * MoveConstructible
 /// 
+/// For `from`, T must also be:
+/// 
+/// * DefaultConstructible
+/// * A container with `emplace_back`
+/// 
 /// Example
 /// -------
 /// 
@@ -68,6 +81,8 @@
 ///     int main() {
 ///         auto v = fit::construct<std::vector<int>>()(5, 5);
 ///         assert(v.size() == 5);
+///         auto w = fit::construct<std::vector<int>>().from(1, 2, 3);
+///         assert(w.size() == 3);
 ///     }
 /// 
 
@@ -76,6 +91,9 @@
 #include <fit/detail/delegate.hpp>
 #include <fit/detail/join.hpp>
 
+#include <fit/detail/holder.hpp>
+
+#include <cstddef>
 #include <initializer_list>
 
 namespace fit { 
@@ -85,6 +103,61 @@ struct by_adaptor;
 
 namespace detail {
 
+template<class T, class=void>
+struct construct_has_reserve
+: std::false_type
+{};
+
+template<class T>
+struct construct_has_reserve<T, typename holder<
+    decltype(std::declval<T&>().reserve(0))
+>::type>
+: std::true_type
+{};
+
+template<class T>
+void construct_reserve(std::true_type, T& x, std::size_t n)
+{
+    x.reserve(n);
+}
+
+template<class T>
+void construct_reserve(std::false_type, T&, std::size_t)
+{}
+
+template<class T>
+void construct_push(T&)
+{}
+
+template<class T, class X, class... Xs>
+void construct_push(T& r, X&& x, Xs&&... xs)
+{
+    r.emplace_back(FIT_FORWARD(X)(x));
+    construct_push(r, FIT_FORWARD(Xs)(xs)...);
+}
+
+template<class T>
+struct construct_from_f
+{
+    constexpr construct_from_f()
+    {}
+
+    template<class... Ts>
+    T operator()(Ts&&... xs) const
+    {
+        T result;
+        construct_reserve(construct_has_reserve<T>(), result, sizeof...(Ts));
+        construct_push(result, FIT_FORWARD(Ts)(xs)...);
+        return result;
+    }
+
+    template<class F>
+    constexpr by_adaptor<F, construct_from_f> by(F f) const
+    {
+        return by_adaptor<F, construct_from_f>(static_cast<F&&>(f), *this);
+    }
+};
+
 template<class T, class=void>
 struct construct_f
 {
@@ -150,6 +223,8 @@ struct construct_f
     {
         return by_adaptor<F, construct_f>(static_cast<F&&>(f), *this);
     }
+
+    static constexpr construct_from_f<T> from = {};
 };
 
 template<class T>
@@ -186,8 +261,16 @@ struct construct_f<T, typename std::enable_if<FIT_IS_LITERAL(T)>::type>
     {
         return by_adaptor<F, construct_f>(static_cast<F&&>(f), *this);
     }
+
+    static constexpr construct_from_f<T> from = {};
 };
 
+template<class T, class X>
+constexpr construct_from_f<T> construct_f<T, X>::from;
+
+template<class T>
+constexpr construct_from_f<T> construct_f<T, typename std::enable_if<FIT_IS_LITERAL(T)>::type>::from;
+
 template<template<class...> class Template>
 struct construct_template_f
 {
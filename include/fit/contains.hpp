@@ -0,0 +1,305 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    contains.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_CONTAINS_H
+#define FIT_GUARD_CONTAINS_H
+
+/// contains
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `contains` function checks if a range contains an element, and `in`
+/// is the same check written as an [infix](/include/fit/infix) operator with
+/// the element first. The fastest way to search is picked from the type of
+/// the range, in this order:
+///
+/// * A compile-time set of integers made with `set_c`, which is checked
+///   with a bitmask when every value is between 0 and 63, otherwise it is a
+///   chain of comparisons that the compiler can turn into a switch.
+/// * A range marked with `sorted`, which uses `std::binary_search`.
+/// * A range with a `find` member function that returns `npos` when the
+///   element is missing, such as `std::string`.
+/// * A range with a `find` member function that returns an iterator, such
+///   as `std::set` or `std::map`.
+/// * A contiguous range of bytes with an integer element, which uses
+///   `memchr`.
+/// * A contiguous range of integers with an integer element, which compares
+///   a block of elements at a time without branching, so the compiler can
+///   use simd instructions.
+/// * Any other range, which uses `std::find`.
+///
+/// A range is contiguous when it is an array or it has `data()` and
+/// `size()` member functions. For the integer paths, an element that can't
+/// be represented by the type of the range is never found.
+///
+/// Synopsis
+/// --------
+///
+///     template<class Range, class T>
+///     bool contains(const Range& r, const T& x);
+///
+///     template<class T, class Range>
+///     bool operator<in>(const T& x, const Range& r);
+///
+///     template<class Range>
+///     constexpr sorted_range<Range> sorted(const Range& r);
+///
+///     template<std::intmax_t... Ns>
+///     constexpr value_set<Ns...> set_c = {};
+///
+/// Semantics
+/// ---------
+///
+///     assert(contains(r, x) == (std::find(begin(r), end(r), x) != end(r)));
+///     assert((x <in> r) == contains(r, x));
+///
+/// Requirements
+/// ------------
+///
+/// Range must be:
+///
+/// * A range, or a `value_set` when `T` is an integer
+/// * Sorted by `operator<`, when it is marked with `sorted`
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <string>
+///     #include <vector>
+///     using namespace fit;
+///
+///     int main() {
+///         std::vector<int> v = { 1, 2, 3 };
+///         assert(2 <in> v);
+///         assert(3 <in> sorted(v));
+///         assert("world" <in> std::string("hello world"));
+///         assert((5 <in> set_c<1, 5, 9>));
+///         assert(!(contains(set_c<1, 5, 9>, 4)));
+///     }
+///
+
+#include <fit/conditional.hpp>
+#include <fit/flip.hpp>
+#include <fit/infix.hpp>
+#include <fit/returns.hpp>
+#include <fit/detail/contiguous.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace fit {
+
+template<std::intmax_t... Ns>
+struct value_set
+{};
+
+template<class Range>
+struct sorted_range
+{
+    const Range * range;
+
+    constexpr sorted_range(const Range& r) : range(&r)
+    {}
+
+    constexpr const Range& base() const
+    {
+        return *range;
+    }
+};
+
+namespace detail {
+
+// Check that x has the same value after converting it to T
+template<class T, class U>
+constexpr bool contains_representable(U x)
+{
+    return static_cast<U>(static_cast<T>(x)) == x &&
+        ((static_cast<T>(x) < T()) == (x < U()));
+}
+
+template<class T>
+constexpr bool value_set_equal(T x, std::intmax_t n)
+{
+    return (x < T()) == (n < 0) && static_cast<std::intmax_t>(x) == n;
+}
+
+template<std::intmax_t... Ns>
+struct value_set_bits
+{
+    static constexpr bool small = true;
+    static constexpr std::uint64_t mask = 0;
+
+    template<class T>
+    static constexpr bool any(T)
+    {
+        return false;
+    }
+};
+
+template<std::intmax_t N, std::intmax_t... Ns>
+struct value_set_bits<N, Ns...>
+{
+    typedef value_set_bits<Ns...> rest;
+    static constexpr bool small = N >= 0 && N < 64 && rest::small;
+    static constexpr std::uint64_t mask = (std::uint64_t(1) << (N & 63)) | rest::mask;
+
+    template<class T>
+    static constexpr bool any(T x)
+    {
+        return detail::value_set_equal(x, N) || rest::any(x);
+    }
+};
+
+template<class Bits, class T>
+constexpr bool value_set_test(std::true_type, T x)
+{
+    return !(x < T()) && static_cast<std::uintmax_t>(x) < 64 && ((Bits::mask >> static_cast<std::uintmax_t>(x)) & 1) != 0;
+}
+
+template<class Bits, class T>
+constexpr bool value_set_test(std::false_type, T x)
+{
+    return Bits::any(x);
+}
+
+struct contains_value_set
+{
+    template<std::intmax_t... Ns, class T, class=typename std::enable_if<(
+        std::is_integral<T>::value
+    )>::type>
+    constexpr bool operator()(value_set<Ns...>, T x) const
+    {
+        typedef value_set_bits<Ns...> bits;
+        return detail::value_set_test<bits>(std::integral_constant<bool, bits::small>(), x);
+    }
+};
+
+struct contains_sorted
+{
+    template<class Range, class T>
+    bool operator()(const sorted_range<Range>& r, const T& x) const
+    {
+        using std::begin;
+        using std::end;
+        return std::binary_search(begin(r.base()), end(r.base()), x);
+    }
+};
+
+struct contains_npos
+{
+    template<class Range, class T>
+    auto operator()(const Range& r, const T& x) const FIT_RETURNS
+    (r.find(x) != Range::npos);
+};
+
+struct contains_member_find
+{
+    template<class Range, class T>
+    auto operator()(const Range& r, const T& x) const FIT_RETURNS
+    (r.find(x) != r.end());
+};
+
+template<class T>
+inline bool contains_scan(const T * p, std::size_t n, T x)
+{
+    std::size_t i = 0;
+    // Compare a block at a time without branching, so the compiler can use
+    // simd instructions
+    for(;i + 64 <= n;i += 64)
+    {
+        const T * block = p + i;
+        T found = 0;
+        for(int j=0;j<64;j++) found |= -T(block[j] == x);
+        if (found) return true;
+    }
+    for(;i<n;i++)
+    {
+        if (p[i] == x) return true;
+    }
+    return false;
+}
+
+struct contains_bytes
+{
+    template<class Range, class T, class E=typename contiguous_element<Range>::type, class=typename std::enable_if<(
+        std::is_integral<E>::value && sizeof(E) == 1 && std::is_integral<T>::value
+    )>::type>
+    bool operator()(const Range& r, T x) const
+    {
+        if (!detail::contains_representable<E>(x)) return false;
+        const E e = static_cast<E>(x);
+        unsigned char c;
+        std::memcpy(&c, &e, 1);
+        std::size_t n = detail::contiguous_size(r);
+        return n != 0 && std::memchr(detail::contiguous_data(r), c, n) != nullptr;
+    }
+};
+
+struct contains_scan_f
+{
+    template<class Range, class T, class E=typename contiguous_element<Range>::type, class=typename std::enable_if<(
+        std::is_integral<E>::value && std::is_integral<T>::value
+    )>::type>
+    bool operator()(const Range& r, T x) const
+    {
+        if (!detail::contains_representable<E>(x)) return false;
+        return detail::contains_scan<E>(detail::contiguous_data(r), detail::contiguous_size(r), static_cast<E>(x));
+    }
+};
+
+struct contains_find
+{
+    template<class Range, class T>
+    bool operator()(const Range& r, const T& x) const
+    {
+        using std::begin;
+        using std::end;
+        return std::find(begin(r), end(r), x) != end(r);
+    }
+};
+
+typedef conditional_adaptor<
+    contains_value_set,
+    contains_sorted,
+    contains_npos,
+    contains_member_find,
+    contains_bytes,
+    contains_scan_f,
+    contains_find
+> contains_f;
+
+struct sorted_f
+{
+    template<class Range>
+    constexpr sorted_range<Range> operator()(const Range& r) const
+    {
+        return sorted_range<Range>(r);
+    }
+};
+
+}
+
+#if FIT_HAS_VARIABLE_TEMPLATES
+template<std::intmax_t... Ns>
+FIT_STATIC_CONSTEXPR value_set<Ns...> set_c = {};
+#endif
+
+FIT_DECLARE_STATIC_VAR(contains, detail::contains_f);
+FIT_DECLARE_STATIC_VAR(in, infix_adaptor<flip_adaptor<detail::contains_f>>);
+FIT_DECLARE_STATIC_VAR(sorted, detail::sorted_f);
+
+} // namespace fit
+
+#endif
@@ -0,0 +1,425 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    cpu_dispatch.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_CPU_DISPATCH_H
+#define FIT_GUARD_FUNCTION_CPU_DISPATCH_H
+
+/// cpu_dispatch
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `cpu_dispatch` function adaptor picks between implementations that
+/// require different cpu features at runtime. Functions can be tagged with a
+/// feature using `cpu::avx512`, `cpu::avx2` or `cpu::sse42`, and functions
+/// that are not tagged can always be used.
+///
+/// Just like `conditional`, the first function that can be called is chosen,
+/// but a tagged function is also skipped when the cpu doesn't support its
+/// feature. The cpu is probed only the first time the adaptor is called with
+/// a set of argument types, and the choice is cached in a static function
+/// pointer, so every call after that is one indirect call.
+///
+/// Since the choice is made once, the features are expected to be the same
+/// for every instance of the adaptor type. The result type is the common type
+/// of all the functions that can be called. At least one function that is
+/// not tagged must be callable, so there is always a function to fall back
+/// on.
+///
+/// Other features can be used by wrapping the function in a
+/// `cpu_feature_adaptor<Feature, F>`, where `Feature` has a static
+/// `supported()` function that returns a `bool`.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Fs>
+///     cpu_dispatch_adaptor<Fs...> cpu_dispatch(Fs... fs);
+///
+///     namespace cpu {
+///
+///     template<class F>
+///     constexpr cpu_feature_adaptor<avx512_feature, F> avx512(F f);
+///
+///     template<class F>
+///     constexpr cpu_feature_adaptor<avx2_feature, F> avx2(F f);
+///
+///     template<class F>
+///     constexpr cpu_feature_adaptor<sse42_feature, F> sse42(F f);
+///
+///     }
+///
+/// Requirements
+/// ------------
+///
+/// Fs must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///
+///     struct sum_avx2
+///     {
+///         int operator()(const int * xs, int n) const
+///         {
+///             // Use avx2 intrinsics here
+///             int r = 0;
+///             for(int i=0;i<n;i++) r += xs[i];
+///             return r;
+///         }
+///     };
+///
+///     struct sum_scalar
+///     {
+///         int operator()(const int * xs, int n) const
+///         {
+///             int r = 0;
+///             for(int i=0;i<n;i++) r += xs[i];
+///             return r;
+///         }
+///     };
+///
+///     int main() {
+///         auto sum = fit::cpu_dispatch(fit::cpu::avx2(sum_avx2()), sum_scalar());
+///         int xs[] = {1, 2, 3};
+///         assert(sum(xs, 3) == 6);
+///     }
+///
+
+#include <fit/is_callable.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/seq.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define FIT_CPU_DISPATCH_BUILTIN 1
+#else
+#define FIT_CPU_DISPATCH_BUILTIN 0
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#define FIT_CPU_DISPATCH_CPUID 1
+#else
+#define FIT_CPU_DISPATCH_CPUID 0
+#endif
+
+namespace fit {
+
+namespace detail {
+
+// The features are only set up by the runtime before the constructors run,
+// so they are set up here in case the selection runs during static
+// initialization
+inline void cpu_init()
+{
+#if FIT_CPU_DISPATCH_BUILTIN
+    __builtin_cpu_init();
+#endif
+}
+
+#if FIT_CPU_DISPATCH_CPUID
+// Checks the cpuid bits, and that the os saves the registers given by mask
+inline bool cpu_has(int leaf, int reg, int bit, unsigned long long mask)
+{
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < leaf) return false;
+    if (mask != 0)
+    {
+        __cpuid(info, 1);
+        if ((info[2] & (1 << 27)) == 0) return false;
+        if ((_xgetbv(0) & mask) != mask) return false;
+    }
+    __cpuidex(info, leaf, 0);
+    return (info[reg] & (1 << bit)) != 0;
+}
+#endif
+
+}
+
+namespace cpu {
+
+struct avx512_feature
+{
+    static bool supported()
+    {
+#if FIT_CPU_DISPATCH_BUILTIN
+        return __builtin_cpu_supports("avx512f") != 0;
+#elif FIT_CPU_DISPATCH_CPUID
+        return detail::cpu_has(7, 1, 16, 0xE6);
+#else
+        return false;
+#endif
+    }
+};
+
+struct avx2_feature
+{
+    static bool supported()
+    {
+#if FIT_CPU_DISPATCH_BUILTIN
+        return __builtin_cpu_supports("avx2") != 0;
+#elif FIT_CPU_DISPATCH_CPUID
+        return detail::cpu_has(7, 1, 5, 0x6);
+#else
+        return false;
+#endif
+    }
+};
+
+struct sse42_feature
+{
+    static bool supported()
+    {
+#if FIT_CPU_DISPATCH_BUILTIN
+        return __builtin_cpu_supports("sse4.2") != 0;
+#elif FIT_CPU_DISPATCH_CPUID
+        return detail::cpu_has(1, 2, 20, 0);
+#else
+        return false;
+#endif
+    }
+};
+
+}
+
+template<class Feature, class F>
+struct cpu_feature_adaptor : detail::callable_base<F>
+{
+    typedef Feature feature;
+    template<class... Ts>
+    constexpr cpu_feature_adaptor(Ts&&... xs) : detail::callable_base<F>(FIT_FORWARD(Ts)(xs)...)
+    {}
+};
+
+namespace detail {
+
+template<class Feature>
+struct cpu_feature_f
+{
+    template<class F>
+    constexpr cpu_feature_adaptor<Feature, F> operator()(F f) const
+    {
+        return cpu_feature_adaptor<Feature, F>(static_cast<F&&>(f));
+    }
+};
+
+// Functions without a feature are always supported
+template<class F>
+struct cpu_supported
+{
+    static bool call()
+    {
+        return true;
+    }
+};
+
+template<class Feature, class F>
+struct cpu_supported<cpu_feature_adaptor<Feature, F>>
+{
+    static bool call()
+    {
+        return Feature::supported();
+    }
+};
+
+template<class F>
+struct is_cpu_feature
+: std::false_type
+{};
+
+template<class Feature, class F>
+struct is_cpu_feature<cpu_feature_adaptor<Feature, F>>
+: std::true_type
+{};
+
+struct cpu_dispatch_none
+{};
+
+template<class T>
+struct cpu_dispatch_type
+{
+    typedef T type;
+};
+
+template<class F, class... Ts>
+struct cpu_dispatch_invoke
+: cpu_dispatch_type<decltype(std::declval<F>()(std::declval<Ts>()...))>
+{};
+
+template<class F, class... Ts>
+struct cpu_dispatch_result_of
+: std::conditional<is_callable<F, Ts...>::value,
+    cpu_dispatch_invoke<F, Ts...>,
+    cpu_dispatch_type<cpu_dispatch_none>
+>::type
+{};
+
+template<class R1, class R2>
+struct cpu_dispatch_combine
+: std::common_type<R1, R2>
+{};
+
+template<class R>
+struct cpu_dispatch_combine<R, cpu_dispatch_none>
+: cpu_dispatch_type<R>
+{};
+
+template<class R>
+struct cpu_dispatch_combine<cpu_dispatch_none, R>
+: cpu_dispatch_type<R>
+{};
+
+template<>
+struct cpu_dispatch_combine<cpu_dispatch_none, cpu_dispatch_none>
+: cpu_dispatch_type<cpu_dispatch_none>
+{};
+
+template<class... Rs>
+struct cpu_dispatch_common;
+
+template<class R>
+struct cpu_dispatch_common<R>
+: cpu_dispatch_type<R>
+{};
+
+template<class R1, class R2, class... Rs>
+struct cpu_dispatch_common<R1, R2, Rs...>
+: cpu_dispatch_common<typename cpu_dispatch_combine<R1, R2>::type, Rs...>
+{};
+
+template<class... Bs>
+struct cpu_dispatch_or
+: std::false_type
+{};
+
+template<class B, class... Bs>
+struct cpu_dispatch_or<B, Bs...>
+: std::integral_constant<bool, (B::value || cpu_dispatch_or<Bs...>::value)>
+{};
+
+}
+
+template<class... Fs>
+struct cpu_dispatch_adaptor
+{
+    std::tuple<detail::callable_base<Fs>...> fs;
+
+    template<class... Xs, class=typename std::enable_if<(
+        std::is_constructible<std::tuple<detail::callable_base<Fs>...>, Xs&&...>::value
+    )>::type>
+    constexpr cpu_dispatch_adaptor(Xs&&... xs) : fs(FIT_FORWARD(Xs)(xs)...)
+    {}
+
+    template<class... Ts>
+    struct result
+    : detail::cpu_dispatch_common<
+        typename detail::cpu_dispatch_result_of<const detail::callable_base<Fs>&, Ts...>::type...
+    >
+    {};
+
+    // Whether there is a function without a feature that can be called
+    template<class... Ts>
+    struct has_fallback
+    : detail::cpu_dispatch_or<std::integral_constant<bool, (
+        !detail::is_cpu_feature<Fs>::value &&
+        is_callable<const detail::callable_base<Fs>&, Ts...>::value
+    )>...>
+    {};
+
+    template<class R, class... Ts>
+    struct function_pointer
+    {
+        typedef R (*type)(const cpu_dispatch_adaptor&, Ts&&...);
+    };
+
+    template<std::size_t I, class R, class... Ts>
+    static R call(const cpu_dispatch_adaptor& self, Ts&&... xs)
+    {
+        return static_cast<R>(std::get<I>(self.fs)(FIT_FORWARD(Ts)(xs)...));
+    }
+
+    template<std::size_t I, class R, class... Ts>
+    static typename function_pointer<R, Ts...>::type pointer(std::true_type)
+    {
+        return &cpu_dispatch_adaptor::call<I, R, Ts...>;
+    }
+
+    template<std::size_t I, class R, class... Ts>
+    static typename function_pointer<R, Ts...>::type pointer(std::false_type)
+    {
+        return nullptr;
+    }
+
+    // Returns the first function that can be called and is supported by the
+    // cpu
+    template<class R, class... Ts, std::size_t... Ns>
+    static typename function_pointer<R, Ts...>::type select(detail::seq<Ns...>)
+    {
+        typedef bool (*supported_pointer)();
+        detail::cpu_init();
+        const typename function_pointer<R, Ts...>::type functions[] = {
+            pointer<Ns, R, Ts...>(is_callable<const detail::callable_base<Fs>&, Ts...>())...
+        };
+        const supported_pointer supported[] = { &detail::cpu_supported<Fs>::call... };
+        for(std::size_t i=0;i<sizeof...(Fs);i++)
+        {
+            if (functions[i] != nullptr && supported[i]()) return functions[i];
+        }
+        return nullptr;
+    }
+
+    template<class... Ts, class R=typename result<Ts&&...>::type, class=typename std::enable_if<(
+        !std::is_same<R, detail::cpu_dispatch_none>::value
+    )>::type>
+    R operator()(Ts&&... xs) const
+    {
+        static_assert(has_fallback<Ts&&...>::value, "cpu_dispatch needs a callable function that doesn't require a cpu feature");
+        static const typename function_pointer<R, Ts...>::type f = select<R, Ts...>(typename detail::gens<sizeof...(Fs)>::type());
+        return f(*this, FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+namespace detail {
+
+struct cpu_dispatch_f
+{
+    template<class... Fs>
+    cpu_dispatch_adaptor<Fs...> operator()(Fs... fs) const
+    {
+        return cpu_dispatch_adaptor<Fs...>(static_cast<Fs&&>(fs)...);
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(cpu_dispatch, detail::cpu_dispatch_f);
+
+namespace cpu {
+
+FIT_DECLARE_STATIC_VAR(avx512, detail::cpu_feature_f<avx512_feature>);
+FIT_DECLARE_STATIC_VAR(avx2, detail::cpu_feature_f<avx2_feature>);
+FIT_DECLARE_STATIC_VAR(sse42, detail::cpu_feature_f<sse42_feature>);
+
+}
+
+} // namespace fit
+
+#endif
@@ -0,0 +1,350 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    decay_borrow.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_DECAY_BORROW_H
+#define FIT_GUARD_DECAY_BORROW_H
+
+/// decay_borrow
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `decay_borrow` function is a unary function object that works like
+/// `decay`, except that lvalues of owning contiguous containers are turned
+/// into non-owning views instead of being copied. A `std::basic_string` is
+/// borrowed as a `basic_borrowed_string`, and a `std::vector` or `std::array`
+/// is borrowed as a `borrowed_span`. Everything else, including rvalues of
+/// containers, is decayed as usual.
+///
+/// This is useful for short-lived closures that never outlive their
+/// arguments. `pack_borrow` and `capture_borrow` work like `pack_decay` and
+/// `capture_decay`, except that they capture each argument with
+/// `decay_borrow`. It can be used with `partial` by passing `decay_borrow(x)`
+/// as the argument, since the views are regular values.
+///
+/// When `FIT_BORROW_CHECK` is defined to 1 (it is off by default), each view
+/// records a checksum of the borrowed elements, and `valid()` returns false
+/// when they have been modified since. This reads the elements, so `valid()`
+/// must only be called while the owner is alive. When the code is also built
+/// with AddressSanitizer, `data`, `begin` and the conversions assert that the
+/// borrowed memory hasn't been freed, by asking the sanitizer instead of
+/// reading it, and `valid()` returns false for freed memory as well.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T>
+///     class borrowed_span;
+///
+///     template<class CharT, class Traits=std::char_traits<CharT>>
+///     class basic_borrowed_string;
+///
+///     template<class T>
+///     constexpr auto decay_borrow(T&& x);
+///
+///     template<class... Ts>
+///     constexpr auto pack_borrow(Ts&&... xs);
+///
+///     template<class... Ts>
+///     constexpr auto capture_borrow(Ts&&... xs);
+///
+/// Semantics
+/// ---------
+///
+///     assert(decay_borrow(s).data() == s.data());
+///     assert(decay_borrow(s).size() == s.size());
+///     assert(decay_borrow(x) == decay(x));
+///     assert(pack_borrow(xs...)(f) == f(decay_borrow(xs)...));
+///
+/// Where `s` is an lvalue `std::basic_string`, `std::vector`, or
+/// `std::array`, and `x` is anything else.
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <string>
+///
+///     int main() {
+///         std::string s = "hello";
+///         auto view = fit::decay_borrow(s);
+///         assert(view.data() == s.data());
+///         assert(view == "hello");
+///     }
+///
+
+#include <fit/config.hpp>
+#include <fit/capture.hpp>
+#include <fit/decay.hpp>
+#include <fit/pack.hpp>
+#include <fit/returns.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifndef FIT_BORROW_CHECK
+#define FIT_BORROW_CHECK 0
+#endif
+
+#if FIT_BORROW_CHECK && FIT_HAS_ADDRESS_SANITIZER
+#include <sanitizer/asan_interface.h>
+#endif
+
+#if FIT_HAS_STRING_VIEW
+#include <string_view>
+#endif
+
+namespace fit {
+
+namespace detail {
+
+template<class T>
+std::size_t borrow_checksum(const T* p, std::size_t n)
+{
+    // FNV-1a over the object representation of the elements
+    const unsigned char* first = reinterpret_cast<const unsigned char*>(p);
+    const unsigned char* last = first + n*sizeof(T);
+    std::size_t h = 2166136261u;
+    for(;first != last;++first) h = (h ^ *first) * 16777619u;
+    return h;
+}
+
+// Whether the sanitizer knows that any of the elements were freed, which
+// doesn't read them
+template<class T>
+bool borrow_released(const T* p, std::size_t n)
+{
+#if FIT_BORROW_CHECK && FIT_HAS_ADDRESS_SANITIZER
+    return __asan_region_is_poisoned(const_cast<T*>(p), n*sizeof(T)) != nullptr;
+#else
+    (void)p;
+    (void)n;
+    return false;
+#endif
+}
+
+}
+
+template<class T>
+class borrowed_span
+{
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef const T& reference;
+    typedef const T& const_reference;
+    typedef const T* iterator;
+    typedef const T* const_iterator;
+
+    borrowed_span() : ptr(nullptr), n(0)
+#if FIT_BORROW_CHECK
+    , checksum(detail::borrow_checksum(ptr, n))
+#endif
+    {}
+
+    borrowed_span(const T* p, std::size_t np) : ptr(p), n(np)
+#if FIT_BORROW_CHECK
+    , checksum(detail::borrow_checksum(ptr, n))
+#endif
+    {}
+
+    // Returns false if the borrowed elements have changed since the view was
+    // created. This always returns true when FIT_BORROW_CHECK is disabled.
+    bool valid() const
+    {
+#if FIT_BORROW_CHECK
+        return !detail::borrow_released(ptr, n) && checksum == detail::borrow_checksum(ptr, n);
+#else
+        return true;
+#endif
+    }
+
+    const T* data() const
+    {
+#if FIT_BORROW_CHECK
+        assert(!detail::borrow_released(ptr, n) && "Borrowed value was destroyed");
+#endif
+        return ptr;
+    }
+
+    std::size_t size() const
+    {
+        return n;
+    }
+
+    bool empty() const
+    {
+        return n == 0;
+    }
+
+    const T* begin() const
+    {
+        return this->data();
+    }
+
+    const T* end() const
+    {
+        return ptr + n;
+    }
+
+    const T& operator[](std::size_t i) const
+    {
+        return ptr[i];
+    }
+
+private:
+    const T* ptr;
+    std::size_t n;
+#if FIT_BORROW_CHECK
+    std::size_t checksum;
+#endif
+};
+
+template<class CharT, class Traits=std::char_traits<CharT>>
+class basic_borrowed_string : public borrowed_span<CharT>
+{
+    typedef borrowed_span<CharT> base;
+public:
+    typedef Traits traits_type;
+
+    basic_borrowed_string()
+    {}
+
+    basic_borrowed_string(const CharT* p, std::size_t np) : base(p, np)
+    {}
+
+    basic_borrowed_string(const CharT* p) : base(p, Traits::length(p))
+    {}
+
+    template<class Allocator>
+    basic_borrowed_string(const std::basic_string<CharT, Traits, Allocator>& s) : base(s.data(), s.size())
+    {}
+
+    std::basic_string<CharT, Traits> str() const
+    {
+        return std::basic_string<CharT, Traits>(this->data(), this->size());
+    }
+
+#if FIT_HAS_STRING_VIEW
+    operator std::basic_string_view<CharT, Traits>() const
+    {
+        return std::basic_string_view<CharT, Traits>(this->data(), this->size());
+    }
+#endif
+
+    int compare(const basic_borrowed_string& rhs) const
+    {
+        std::size_t len = this->size() < rhs.size() ? this->size() : rhs.size();
+        int r = len == 0 ? 0 : Traits::compare(this->data(), rhs.data(), len);
+        if (r != 0) return r;
+        return this->size() < rhs.size() ? -1 : (this->size() > rhs.size() ? 1 : 0);
+    }
+
+    friend bool operator==(const basic_borrowed_string& x, const basic_borrowed_string& y)
+    {
+        return x.size() == y.size() && x.compare(y) == 0;
+    }
+
+    friend bool operator!=(const basic_borrowed_string& x, const basic_borrowed_string& y)
+    {
+        return !(x == y);
+    }
+
+    friend bool operator<(const basic_borrowed_string& x, const basic_borrowed_string& y)
+    {
+        return x.compare(y) < 0;
+    }
+};
+
+typedef basic_borrowed_string<char> borrowed_string;
+typedef basic_borrowed_string<wchar_t> borrowed_wstring;
+
+namespace detail {
+
+template<class T>
+struct borrow_traits
+{};
+
+template<class CharT, class Traits, class Allocator>
+struct borrow_traits<std::basic_string<CharT, Traits, Allocator>>
+{
+    typedef basic_borrowed_string<CharT, Traits> type;
+};
+
+template<class T, class Allocator>
+struct borrow_traits<std::vector<T, Allocator>>
+{
+    typedef borrowed_span<T> type;
+};
+
+// A vector of bools is not contiguous
+template<class Allocator>
+struct borrow_traits<std::vector<bool, Allocator>>
+{};
+
+template<class T, std::size_t N>
+struct borrow_traits<std::array<T, N>>
+{
+    typedef borrowed_span<T> type;
+};
+
+template<class T, class=void>
+struct is_borrowable
+: std::false_type
+{};
+
+template<class T>
+struct is_borrowable<T, typename holder<
+    typename borrow_traits<typename std::decay<T>::type>::type
+>::type>
+: std::is_lvalue_reference<T>
+{};
+
+struct decay_borrow_f
+{
+    template<class T, typename std::enable_if<(is_borrowable<T&&>::value), int>::type = 0>
+    typename borrow_traits<typename std::decay<T>::type>::type
+    operator()(T&& x) const
+    {
+        return typename borrow_traits<typename std::decay<T>::type>::type(x.data(), x.size());
+    }
+
+    template<class T, typename std::enable_if<(!is_borrowable<T&&>::value), int>::type = 0>
+    constexpr auto operator()(T&& x) const FIT_RETURNS
+    (
+        decay_f()(FIT_FORWARD(T)(x))
+    );
+};
+
+}
+
+namespace detail {
+
+struct pack_borrow_f
+{
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    (
+        pack_f()(decay_borrow_f()(FIT_FORWARD(Ts)(xs))...)
+    );
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(decay_borrow, detail::decay_borrow_f);
+FIT_DECLARE_STATIC_VAR(pack_borrow, detail::pack_borrow_f);
+FIT_DECLARE_STATIC_VAR(capture_borrow, detail::capture_f<detail::pack_borrow_f>);
+
+} // namespace fit
+
+#endif
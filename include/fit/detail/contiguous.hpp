@@ -0,0 +1,56 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    contiguous.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_DETAIL_CONTIGUOUS_H
+#define FIT_GUARD_DETAIL_CONTIGUOUS_H
+
+#include <fit/returns.hpp>
+#include <fit/detail/holder.hpp>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace fit { namespace detail {
+
+// A range is contiguous when it is an array or it has data() and size()
+template<class Range>
+constexpr auto contiguous_data(const Range& r) FIT_RETURNS(r.data());
+
+template<class T, std::size_t N>
+constexpr const T * contiguous_data(const T (&a)[N])
+{
+    return a;
+}
+
+template<class Range>
+constexpr auto contiguous_size(const Range& r) FIT_RETURNS(r.size());
+
+template<class T, std::size_t N>
+constexpr std::size_t contiguous_size(const T (&)[N])
+{
+    return N;
+}
+
+template<class Range, class=void>
+struct contiguous_element
+{};
+
+template<class Range>
+struct contiguous_element<Range, typename holder<
+    decltype(detail::contiguous_data(std::declval<const Range&>())),
+    decltype(detail::contiguous_size(std::declval<const Range&>()))
+>::type>
+: std::enable_if<std::is_pointer<decltype(detail::contiguous_data(std::declval<const Range&>()))>::value,
+    typename std::remove_cv<typename std::remove_pointer<
+        decltype(detail::contiguous_data(std::declval<const Range&>()))
+    >::type>::type
+>
+{};
+
+}} // namespace fit
+
+#endif
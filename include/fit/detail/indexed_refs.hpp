@@ -0,0 +1,46 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    indexed_refs.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_DETAIL_INDEXED_REFS_H
+#define FIT_GUARD_DETAIL_INDEXED_REFS_H
+
+#include <fit/detail/forward.hpp>
+#include <fit/detail/seq.hpp>
+#include <cstddef>
+
+namespace fit { namespace detail {
+
+template<std::size_t N, class T>
+struct indexed_ref
+{
+    T&& value;
+    constexpr indexed_ref(T&& x) : value(FIT_FORWARD(T)(x))
+    {}
+};
+
+// Holds a reference to each argument, so any of them can be found by index
+// without recursion
+template<class Seq, class... Ts>
+struct indexed_refs;
+
+template<std::size_t... Ns, class... Ts>
+struct indexed_refs<seq<Ns...>, Ts...>
+: indexed_ref<Ns, Ts>...
+{
+    constexpr indexed_refs(Ts&&... xs) : indexed_ref<Ns, Ts>(FIT_FORWARD(Ts)(xs))...
+    {}
+};
+
+template<std::size_t N, class T>
+constexpr T&& indexed_get(const indexed_ref<N, T>& r)
+{
+    return FIT_FORWARD(T)(r.value);
+}
+
+}} // namespace fit
+
+#endif
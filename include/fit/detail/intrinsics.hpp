@@ -23,6 +23,7 @@
 #define FIT_IS_LITERAL(...) __is_literal(__VA_ARGS__)
 #define FIT_IS_POLYMORPHIC(...) __is_polymorphic(__VA_ARGS__)
 #define FIT_IS_FINAL(...) __is_final(__VA_ARGS__)
+#define FIT_IS_TRIVIALLY_COPYABLE(...) __is_trivially_copyable(__VA_ARGS__)
 #elif defined(__GNUC__)
 #define FIT_IS_CONSTRUCTIBLE(...) std::is_constructible<__VA_ARGS__>::value
 #define FIT_IS_CONVERTIBLE(...) std::is_convertible<__VA_ARGS__>::value
@@ -36,6 +37,11 @@
 #else
 #define FIT_IS_FINAL(...) __is_final(__VA_ARGS__)
 #endif
+#if __GNUC__ < 5
+#define FIT_IS_TRIVIALLY_COPYABLE(...) (__has_trivial_copy(__VA_ARGS__) && __has_trivial_destructor(__VA_ARGS__))
+#else
+#define FIT_IS_TRIVIALLY_COPYABLE(...) __is_trivially_copyable(__VA_ARGS__)
+#endif
 #elif defined(_MSC_VER)
 #define FIT_IS_CONSTRUCTIBLE(...) __is_constructible(__VA_ARGS__)
 #define FIT_IS_CONVERTIBLE(...) __is_convertible_to(__VA_ARGS__)
@@ -45,6 +51,7 @@
 #define FIT_IS_LITERAL(...) std::is_literal_type<__VA_ARGS__>::value
 #define FIT_IS_POLYMORPHIC(...) __is_polymorphic(__VA_ARGS__)
 #define FIT_IS_FINAL(...) __is_final(__VA_ARGS__)
+#define FIT_IS_TRIVIALLY_COPYABLE(...) __is_trivially_copyable(__VA_ARGS__)
 #else
 #define FIT_IS_CONSTRUCTIBLE(...) std::is_constructible<__VA_ARGS__>::value
 #define FIT_IS_CONVERTIBLE(...) std::is_convertible<__VA_ARGS__>::value
@@ -54,6 +61,7 @@
 #define FIT_IS_LITERAL(...) std::is_literal_type<__VA_ARGS__>::value
 #define FIT_IS_POLYMORPHIC(...) std::is_polymorphic<__VA_ARGS__>::value
 #define FIT_IS_FINAL(...) (false)
+#define FIT_IS_TRIVIALLY_COPYABLE(...) std::is_trivially_copyable<__VA_ARGS__>::value
 #endif
 
 #if FIT_NO_STD_DEFAULT_CONSTRUCTIBLE
@@ -62,6 +70,12 @@
 #define FIT_IS_DEFAULT_CONSTRUCTIBLE FIT_IS_CONSTRUCTIBLE
 #endif
 
+#if FIT_HAS_UNIQUE_OBJECT_REPRESENTATIONS
+#define FIT_HAS_UNIQUE_REPRESENTATION(...) __has_unique_object_representations(__VA_ARGS__)
+#else
+#define FIT_HAS_UNIQUE_REPRESENTATION(...) (false)
+#endif
+
 namespace fit { namespace detail {
 
 template<class T, class=void>
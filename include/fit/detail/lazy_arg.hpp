@@ -0,0 +1,79 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    lazy_arg.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_LAZY_ARG_H
+#define FIT_GUARD_LAZY_ARG_H
+
+#include <fit/returns.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/move.hpp>
+#include <type_traits>
+
+namespace fit { namespace detail {
+
+// An argument that is computed by a thunk only when it is used. Adaptors
+// that can stop before using every argument declare a fit_lazy_args_tag,
+// so adaptors such as by can pass their arguments this way.
+template<class F>
+struct lazy_arg
+{
+    F f;
+
+    constexpr lazy_arg(F&& x) : f(fit::move(x))
+    {}
+};
+
+template<class F>
+constexpr lazy_arg<F> make_lazy_arg(F f)
+{
+    return lazy_arg<F>(fit::move(f));
+}
+
+template<class T>
+struct is_lazy_arg
+: std::false_type
+{};
+
+template<class F>
+struct is_lazy_arg<lazy_arg<F>>
+: std::true_type
+{};
+
+template<class T, typename std::enable_if<(
+    !is_lazy_arg<typename std::decay<T>::type>::value
+), int>::type = 0>
+constexpr T&& lazy_arg_get(T&& x)
+{
+    return FIT_FORWARD(T)(x);
+}
+
+template<class F>
+constexpr auto lazy_arg_get(const lazy_arg<F>& x) FIT_RETURNS
+(x.f());
+
+template<class T>
+struct lazy_arg_result
+{
+    typedef decltype(detail::lazy_arg_get(std::declval<T>())) type;
+};
+
+template<class F, class=void>
+struct has_lazy_args
+: std::false_type
+{};
+
+template<class F>
+struct has_lazy_args<F, typename holder<
+    typename F::fit_lazy_args_tag
+>::type>
+: std::is_same<typename F::fit_lazy_args_tag, F>
+{};
+
+}} // namespace fit
+
+#endif
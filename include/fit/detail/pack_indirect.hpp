@@ -0,0 +1,25 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    pack_indirect.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_PACK_INDIRECT_H
+#define FIT_GUARD_PACK_INDIRECT_H
+
+#include <type_traits>
+
+namespace fit { namespace detail {
+
+// Elements of a pack that are passed to the function as a reference to the
+// value they hold, instead of as themselves. A specialization has a `type`
+// for the reference, and a static `get` that returns it.
+template<class T, class=void>
+struct pack_indirect
+: std::false_type
+{};
+
+}} // namespace fit
+
+#endif
@@ -0,0 +1,21 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    relaxed_constexpr.hpp
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_RELAXED_CONSTEXPR_HPP
+#define FIT_GUARD_RELAXED_CONSTEXPR_HPP
+
+#include <fit/config.hpp>
+
+// Functions that use loops or mutation can only be constexpr with relaxed
+// constexpr, otherwise they are evaluated at runtime.
+#if FIT_HAS_RELAXED_CONSTEXPR
+#define FIT_RELAXED_CONSTEXPR constexpr
+#else
+#define FIT_RELAXED_CONSTEXPR
+#endif
+
+#endif
@@ -44,20 +44,28 @@ constexpr const T& static_const_var()
 
 } // namespace fit
 
-#if FIT_HAS_RELAXED_CONSTEXPR || defined(_MSC_VER)
+// With inline variables, each variable is defined once for the whole program
+// instead of having a reference in every translation unit
+#if FIT_HAS_INLINE_VARIABLES
+#define FIT_STATIC_CONSTEXPR inline constexpr
+#elif FIT_HAS_RELAXED_CONSTEXPR || defined(_MSC_VER)
 #define FIT_STATIC_CONSTEXPR const constexpr
 #else
 #define FIT_STATIC_CONSTEXPR static constexpr
 #endif
 
-#if defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7
+#if FIT_HAS_INLINE_VARIABLES
+#define FIT_STATIC_AUTO_REF inline constexpr auto&
+#elif defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7
 #define FIT_STATIC_AUTO_REF extern __attribute__((weak)) constexpr auto
 #else
 #define FIT_STATIC_AUTO_REF static constexpr auto&
 #endif
 
+#if FIT_HAS_INLINE_VARIABLES
+#define FIT_STATIC_CONST_VAR(name) inline constexpr auto name
 // On gcc 4.6 use weak variables
-#if defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7
+#elif defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7
 #define FIT_STATIC_CONST_VAR(name) extern __attribute__((weak)) constexpr auto name
 #else
 #define FIT_STATIC_CONST_VAR(name) static constexpr auto& name = fit::detail::static_const_var_factory()
@@ -0,0 +1,161 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    devirtualize.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_DEVIRTUALIZE_H
+#define FIT_GUARD_FUNCTION_DEVIRTUALIZE_H
+
+/// devirtualize
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `devirtualize` function adaptor dereferences the object before calling
+/// it, just like [`indirect`](/include/fit/indirect), but it is meant for
+/// polymorphic function objects. It takes a closed list of `final` types. When
+/// called, the dynamic type of the object is compared against each of them in
+/// order, and on a match the `operator()` of that type is called directly,
+/// which the compiler can inline. If none of them match, the virtual call is
+/// made instead.
+///
+/// Each candidate costs one pointer comparison of the `typeid`, which needs
+/// RTTI. So the list should be short and ordered by how often each type is
+/// expected.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Finals, class F>
+///     constexpr devirtualize_adaptor<F, Finals...> devirtualize(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(devirtualize<Finals...>(f)(xs...) == (*f)(xs...));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * MoveConstructible
+/// * Dereferenceable
+///
+/// Finals must be:
+///
+/// * Derived from the type of `*f`
+/// * Declared `final`
+/// * Callable with the same arguments as `*f`
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <memory>
+///
+///     struct shape
+///     {
+///         virtual ~shape() {}
+///         virtual int operator()(int x) const = 0;
+///     };
+///
+///     struct square final : shape
+///     {
+///         int operator()(int x) const override
+///         {
+///             return x*x;
+///         }
+///     };
+///
+///     struct twice final : shape
+///     {
+///         int operator()(int x) const override
+///         {
+///             return 2*x;
+///         }
+///     };
+///
+///     int main() {
+///         std::unique_ptr<shape> s(new square());
+///         assert((fit::devirtualize<square, twice>(std::move(s))(3) == 9));
+///     }
+///
+
+#include <fit/config.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/move.hpp>
+#include <type_traits>
+#include <typeinfo>
+
+namespace fit {
+
+namespace detail {
+
+template<class... Ts>
+struct devirtualize_list
+{};
+
+template<class Base, class Final>
+struct devirtualize_final
+: std::conditional<std::is_const<Base>::value, const Final, Final>
+{};
+
+template<class R, class Base, class... Ts>
+R devirtualize_call(Base& base, devirtualize_list<>, Ts&&... xs)
+{
+    return static_cast<R>(base(FIT_FORWARD(Ts)(xs)...));
+}
+
+template<class R, class Base, class Final, class... Finals, class... Ts>
+R devirtualize_call(Base& base, devirtualize_list<Final, Finals...>, Ts&&... xs)
+{
+    static_assert(std::is_base_of<typename std::remove_cv<Base>::type, Final>::value, "Final type must be derived from the base type");
+#if FIT_HAS_STD_14
+    // A type derived from Final would fail the typeid check, so it would
+    // always take the virtual call
+    static_assert(std::is_final<Final>::value, "Final type must be declared final");
+#endif
+    typedef typename devirtualize_final<Base, Final>::type final_type;
+    // Comparing the addresses avoids a string compare on a mismatch. A type
+    // can have more than one type_info across shared libraries, but then
+    // the virtual call is still used.
+    if (&typeid(base) == &typeid(Final)) return static_cast<R>(static_cast<final_type&>(base)(FIT_FORWARD(Ts)(xs)...));
+    return devirtualize_call<R>(base, devirtualize_list<Finals...>(), FIT_FORWARD(Ts)(xs)...);
+}
+
+}
+
+template<class F, class... Finals>
+struct devirtualize_adaptor
+{
+    F f;
+
+    template<class X, class=typename std::enable_if<(
+        std::is_constructible<F, X&&>::value
+    )>::type>
+    constexpr devirtualize_adaptor(X&& x) : f(FIT_FORWARD(X)(x))
+    {}
+
+    template<class... Ts>
+    decltype((*std::declval<const F&>())(std::declval<Ts>()...))
+    operator()(Ts&&... xs) const
+    {
+        typedef decltype((*std::declval<const F&>())(std::declval<Ts>()...)) result_type;
+        return detail::devirtualize_call<result_type>(*f, detail::devirtualize_list<Finals...>(), FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+template<class... Finals, class F>
+constexpr devirtualize_adaptor<F, Finals...> devirtualize(F f)
+{
+    return devirtualize_adaptor<F, Finals...>(fit::move(f));
+}
+
+} // namespace fit
+
+#endif
@@ -0,0 +1,167 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    filter.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_FILTER_H
+#define FIT_GUARD_FUNCTION_FILTER_H
+
+/// filter_c
+/// ========
+///
+/// Description
+/// -----------
+///
+/// The `filter_c` function adaptor calls the function with only the
+/// arguments whose type satisfies the predicate. The predicate is a class
+/// template, such as `std::is_integral`, that is instantiated with the
+/// decayed type of each argument, and it must have a static `value`
+/// convertible to `bool`. The arguments that are kept are forwarded to the
+/// function in their original order.
+///
+/// The kept indices are computed at compile time, so the function is called
+/// once with the arguments forwarded directly, without building a
+/// temporary sequence for each argument.
+///
+/// The `unpack_filter` function adaptor is the same as
+/// `unpack(filter_c<Pred>(f))`. It filters the elements of one or more
+/// sequences.
+///
+/// Synopsis
+/// --------
+///
+///     template<template<class> class Pred, class F>
+///     constexpr filter_adaptor<Pred, F> filter_c(F f);
+///
+///     template<template<class> class Pred, class F>
+///     constexpr unpack_adaptor<filter_adaptor<Pred, F>> unpack_filter(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(filter_c<std::is_integral>(f)(1, 2.0, 3) == f(1, 3));
+///     assert(unpack_filter<std::is_integral>(f)(make_tuple(1, 2.0, 3)) == f(1, 3));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <tuple>
+///
+///     struct sum
+///     {
+///         template<class... Ts>
+///         int operator()(Ts... xs) const
+///         {
+///             int r = 0;
+///             (void)std::initializer_list<int>{(r += xs, 0)...};
+///             return r;
+///         }
+///     };
+///
+///     int main() {
+///         auto r = fit::unpack_filter<std::is_integral>(sum())(std::make_tuple(1, 2.5, 3, "x"));
+///         assert(r == 4);
+///     }
+///
+
+#include <fit/unpack.hpp>
+#include <fit/always.hpp>
+#include <fit/returns.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/indexed_refs.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/detail/seq.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace fit {
+
+namespace detail {
+
+// Concatenates the index lists
+template<class... Seqs>
+struct filter_join
+: seq<>
+{};
+
+template<std::size_t... Ns>
+struct filter_join<seq<Ns...>>
+: seq<Ns...>
+{};
+
+template<std::size_t... Ns, std::size_t... Ms, class... Seqs>
+struct filter_join<seq<Ns...>, seq<Ms...>, Seqs...>
+: filter_join<seq<Ns..., Ms...>, Seqs...>
+{};
+
+template<template<class> class Pred, class Seq, class... Ts>
+struct filter_indices;
+
+template<template<class> class Pred, std::size_t... Ns, class... Ts>
+struct filter_indices<Pred, seq<Ns...>, Ts...>
+: filter_join<typename std::conditional<
+    Pred<typename std::decay<Ts>::type>::value, seq<Ns>, seq<>
+>::type...>
+{};
+
+template<class F, class Refs, std::size_t... Ns>
+constexpr auto filter_call(const F& f, const Refs& refs, seq<Ns...>) FIT_RETURNS
+(
+    (void)refs, f(detail::indexed_get<Ns>(refs)...)
+);
+
+}
+
+template<template<class> class Pred, class F>
+struct filter_adaptor : detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(filter_adaptor, detail::callable_base<F>);
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    FIT_RETURNS_CLASS(filter_adaptor);
+
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    (
+        detail::filter_call(
+            FIT_MANGLE_CAST(const detail::callable_base<F>&)(FIT_CONST_THIS->base_function(xs...)),
+            detail::indexed_refs<typename detail::gens<sizeof...(Ts)>::type, Ts...>(FIT_FORWARD(Ts)(xs)...),
+            typename detail::filter_indices<Pred, typename detail::gens<sizeof...(Ts)>::type, Ts...>::type()
+        )
+    );
+};
+
+template<template<class> class Pred, class F>
+constexpr filter_adaptor<Pred, F> filter_c(F f)
+{
+    return filter_adaptor<Pred, F>(fit::move(f));
+}
+
+template<template<class> class Pred, class F>
+constexpr unpack_adaptor<filter_adaptor<Pred, F>> unpack_filter(F f)
+{
+    return unpack_adaptor<filter_adaptor<Pred, F>>(filter_adaptor<Pred, F>(fit::move(f)));
+}
+
+} // namespace fit
+
+#endif
@@ -0,0 +1,726 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    fix_parallel.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_FIX_PARALLEL_H
+#define FIT_GUARD_FUNCTION_FIX_PARALLEL_H
+
+/// fix_parallel
+/// ============
+///
+/// Description
+/// -----------
+///
+/// The `fix_parallel` function adaptor is a fixed-point combinator, like
+/// [`fix`](/include/fit/fix), for divide-and-conquer recursions. Besides
+/// calling `self` directly, the function can call `self.fork(xs...)`, which
+/// calls `self(x)` for each argument in parallel and returns a `std::tuple` of
+/// the results:
+///
+///     auto [a, b] = self.fork(left, right);
+///
+/// The first call runs on the current thread, while the others are queued as
+/// tasks that idle threads can steal. Then the thread waits for the stolen
+/// tasks, running other tasks while it waits. The tasks run on a
+/// `fork_join_pool`, which is either given to `fix_parallel` or a default
+/// pool with a thread for each core. The calling thread waits for the result,
+/// unless it is already a thread of the pool. When a call throws, `fork`
+/// still waits for the other calls, and then rethrows the exception, so it
+/// reaches the calling thread like it would with `fix`.
+///
+/// Small calls are not worth a task, so the `cutoff` says when to stop
+/// forking. It is either an integer, which is the depth of the recursion
+/// after which calls are serial, or a predicate that is called with the
+/// arguments of each call and returns true when the call is small enough to
+/// run serially. A serial call is passed a different `self`, whose `fork`
+/// calls each argument in turn, so the rest of the recursion runs like `fix`
+/// does with no synchronization at all.
+///
+/// Since both kinds of `self` are passed to the function, it should take
+/// `self` as a template parameter. When `FIT_SINGLE_THREADED` is set,
+/// every call is serial.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F, class Cutoff>
+///     fix_parallel_adaptor<F, Cutoff> fix_parallel(F f, Cutoff cutoff);
+///
+///     template<class F, class Cutoff>
+///     fix_parallel_adaptor<F, Cutoff> fix_parallel(F f, Cutoff cutoff, fork_join_pool& pool);
+///
+/// Semantics
+/// ---------
+///
+///     assert(fix_parallel(f, cutoff)(xs...) == fix(f)(xs...));
+///
+/// Where `self.fork(xs...)` is `std::make_tuple(self(xs)...)`.
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [ConstFunctionObject](ConstFunctionObject)
+/// * MoveConstructible
+///
+/// Cutoff must be an integer, or:
+///
+/// * [ConstFunctionObject](ConstFunctionObject)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///
+///     struct fib
+///     {
+///         template<class Self>
+///         long operator()(Self self, int n) const
+///         {
+///             if (n < 2) return n;
+///             auto r = self.fork(n - 1, n - 2);
+///             return std::get<0>(r) + std::get<1>(r);
+///         }
+///     };
+///
+///     struct small
+///     {
+///         bool operator()(int n) const
+///         {
+///             return n < 15;
+///         }
+///     };
+///
+///     int main() {
+///         fit::fork_join_pool pool(2);
+///         assert(fit::fix_parallel(fib(), small(), pool)(25) == 75025);
+///         assert(fit::fix_parallel(fib(), 4)(20) == 6765);
+///     }
+///
+
+#include <fit/pack.hpp>
+#include <fit/is_callable.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/compressed_pair.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <new>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#if !FIT_SINGLE_THREADED
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#endif
+
+namespace fit {
+
+template<class F>
+struct fix_serial_self;
+
+namespace detail {
+
+template<class F, class... Ts>
+struct fix_parallel_result
+{
+    typedef decltype(std::declval<const F&>()(
+        std::declval<fix_serial_self<F>>(), std::declval<Ts>()...
+    )) type;
+};
+
+template<class Cutoff, class... Ts>
+constexpr typename std::enable_if<std::is_integral<Cutoff>::value, bool>::type
+fix_parallel_is_serial(const Cutoff& cutoff, int depth, const Ts&...)
+{
+    return Cutoff(depth) >= cutoff;
+}
+
+template<class Cutoff, class... Ts>
+constexpr typename std::enable_if<!std::is_integral<Cutoff>::value, bool>::type
+fix_parallel_is_serial(const Cutoff& cutoff, int, const Ts&... xs)
+{
+    return cutoff(xs...);
+}
+
+}
+
+template<class F>
+struct fix_serial_self
+{
+    const F * f;
+
+    explicit fix_serial_self(const F& fun) : f(&fun)
+    {}
+
+    template<class... Ts>
+    typename detail::fix_parallel_result<F, Ts&&...>::type
+    operator()(Ts&&... xs) const
+    {
+        return (*f)(*this, FIT_FORWARD(Ts)(xs)...);
+    }
+
+    template<class... Ts>
+    std::tuple<typename detail::fix_parallel_result<F, Ts&&>::type...>
+    fork(Ts&&... xs) const
+    {
+        // Brace initialization calls them in order
+        return std::tuple<typename detail::fix_parallel_result<F, Ts&&>::type...>{
+            (*this)(FIT_FORWARD(Ts)(xs))...
+        };
+    }
+};
+
+#if !FIT_SINGLE_THREADED
+
+namespace detail {
+
+struct fork_worker;
+class fork_scheduler;
+
+struct fork_task
+{
+    std::atomic<bool> done;
+    std::exception_ptr error;
+
+    fork_task() : done(false)
+    {}
+
+    fork_task(const fork_task&) = delete;
+    fork_task& operator=(const fork_task&) = delete;
+
+    virtual void execute(fork_worker& w) = 0;
+protected:
+    ~fork_task()
+    {}
+};
+
+// The tasks of a worker are pushed and popped at the back by the worker, and
+// stolen from the front by other workers, so thieves take the oldest, and
+// usually largest, tasks
+struct fork_worker
+{
+    fork_scheduler * owner;
+    std::mutex m;
+    std::deque<fork_task*> tasks;
+    unsigned seed;
+
+    fork_worker(fork_scheduler * s, std::size_t i) : owner(s), seed(unsigned(i) * 2654435761u + 1)
+    {}
+
+    fork_task * pop_back()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (tasks.empty()) return nullptr;
+        fork_task * t = tasks.back();
+        tasks.pop_back();
+        return t;
+    }
+
+    fork_task * pop_front()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (tasks.empty()) return nullptr;
+        fork_task * t = tasks.front();
+        tasks.pop_front();
+        return t;
+    }
+
+    unsigned next_random()
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        return seed;
+    }
+};
+
+inline fork_worker *& fork_current_worker()
+{
+    static thread_local fork_worker * w = nullptr;
+    return w;
+}
+
+class fork_scheduler
+{
+    std::vector<std::unique_ptr<fork_worker>> workers;
+    std::vector<std::thread> threads;
+    std::deque<fork_task*> submitted;
+    std::mutex m;
+    std::condition_variable cv;
+    std::atomic<long> pending;
+    std::atomic<int> sleepers;
+    bool stop;
+
+    fork_task * take_submitted()
+    {
+        std::lock_guard<std::mutex> lock(m);
+        if (submitted.empty()) return nullptr;
+        fork_task * t = submitted.front();
+        submitted.pop_front();
+        return t;
+    }
+
+    fork_task * take(fork_worker& w)
+    {
+        if (pending.load() == 0) return nullptr;
+        fork_task * t = w.pop_back();
+        if (t == nullptr) t = this->take_submitted();
+        for(std::size_t i=0,n=workers.size(),start=w.next_random();t == nullptr && i<n;i++)
+        {
+            fork_worker& victim = *workers[(start + i) % n];
+            if (&victim != &w) t = victim.pop_front();
+        }
+        if (t != nullptr) pending.fetch_sub(1);
+        return t;
+    }
+
+    void notify()
+    {
+        // A worker counts itself as a sleeper before it checks for pending
+        // tasks, so either it sees the task, or it is woken up here
+        if (sleepers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            cv.notify_one();
+        }
+    }
+
+    void loop(fork_worker& w)
+    {
+        fork_current_worker() = &w;
+        for(;;)
+        {
+            fork_task * t = this->take(w);
+            if (t != nullptr)
+            {
+                t->execute(w);
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(m);
+            if (stop) break;
+            sleepers.fetch_add(1);
+            while (pending.load() == 0 && !stop) cv.wait(lock);
+            sleepers.fetch_sub(1);
+        }
+        fork_current_worker() = nullptr;
+    }
+public:
+    explicit fork_scheduler(std::size_t n) : pending(0), sleepers(0), stop(false)
+    {
+        if (n == 0) n = 1;
+        for(std::size_t i=0;i<n;i++) workers.emplace_back(new fork_worker(this, i));
+        for(std::size_t i=0;i<n;i++) threads.emplace_back(&fork_scheduler::loop, this, std::ref(*workers[i]));
+    }
+
+    fork_scheduler(const fork_scheduler&) = delete;
+    fork_scheduler& operator=(const fork_scheduler&) = delete;
+
+    ~fork_scheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stop = true;
+        }
+        cv.notify_all();
+        for(auto&& t:threads) t.join();
+    }
+
+    std::size_t size() const
+    {
+        return workers.size();
+    }
+
+    bool owns(const fork_worker * w) const
+    {
+        return w != nullptr && w->owner == this;
+    }
+
+    void push(fork_worker& w, fork_task& t)
+    {
+        {
+            std::lock_guard<std::mutex> lock(w.m);
+            w.tasks.push_back(&t);
+        }
+        pending.fetch_add(1);
+        this->notify();
+    }
+
+    // Takes back the last task pushed, if it hasn't been stolen
+    bool pop(fork_worker& w, fork_task& t)
+    {
+        std::lock_guard<std::mutex> lock(w.m);
+        if (w.tasks.empty() || w.tasks.back() != &t) return false;
+        w.tasks.pop_back();
+        pending.fetch_sub(1);
+        return true;
+    }
+
+    void join(fork_worker& w, fork_task& t)
+    {
+        if (this->pop(w, t)) t.execute(w);
+        else while (!t.done.load(std::memory_order_acquire))
+        {
+            fork_task * other = this->take(w);
+            if (other != nullptr) other->execute(w);
+            else std::this_thread::yield();
+        }
+    }
+
+    void submit(fork_task& t)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            submitted.push_back(&t);
+        }
+        pending.fetch_add(1);
+        this->notify();
+    }
+};
+
+template<class R>
+class fork_result
+{
+    typename std::aligned_storage<sizeof(R), alignof(R)>::type data;
+    bool has_value;
+public:
+    fork_result() : has_value(false)
+    {}
+
+    fork_result(const fork_result&) = delete;
+    fork_result& operator=(const fork_result&) = delete;
+
+    // A result is left when another call of the fork throws
+    ~fork_result()
+    {
+        if (has_value) reinterpret_cast<R*>(&data)->~R();
+    }
+
+    template<class X>
+    void set(X&& x)
+    {
+        new (&data) R(FIT_FORWARD(X)(x));
+        has_value = true;
+    }
+
+    R take()
+    {
+        R * p = reinterpret_cast<R*>(&data);
+        R r(fit::move(*p));
+        p->~R();
+        has_value = false;
+        return r;
+    }
+};
+
+template<class Self, class R>
+struct fork_call
+{
+    Self self;
+
+    template<class... Ts>
+    R operator()(Ts&&... xs) const
+    {
+        return self(FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+template<class Self, class R>
+struct fork_call_rest
+{
+    Self self;
+
+    template<class... Ts>
+    R operator()(Ts&&... xs) const
+    {
+        return self.fork(FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+// A task on the stack of the thread that forks it, which refers to the
+// arguments with a pack of references, since it always finishes before the
+// fork returns
+template<template<class, class> class Call, class Self, class Pack, class R>
+struct fork_branch : fork_task
+{
+    Self self;
+    Pack args;
+    fork_result<R> result;
+
+    fork_branch(const Self& s, Pack p) : self(s), args(fit::move(p))
+    {}
+
+    // An exception is kept for the thread that joins the task, since it
+    // can't leave the thread that runs it
+    void run(fork_worker& w)
+    {
+        try
+        {
+            Self s = self;
+            s.worker = &w;
+            result.set(args(Call<Self, R>{s}));
+        }
+        catch(...)
+        {
+            this->error = std::current_exception();
+        }
+    }
+
+    R get()
+    {
+        if (this->error) std::rethrow_exception(this->error);
+        return result.take();
+    }
+
+    virtual void execute(fork_worker& w)
+    {
+        this->run(w);
+        this->done.store(true, std::memory_order_release);
+    }
+};
+
+// The first call of a recursion, which is waited on by a thread that is not
+// in the pool
+template<class Self, class Pack, class R>
+struct fork_root : fork_branch<fork_call, Self, Pack, R>
+{
+    std::mutex m;
+    std::condition_variable cv;
+
+    fork_root(const Self& s, Pack p) : fork_branch<fork_call, Self, Pack, R>(s, fit::move(p))
+    {}
+
+    virtual void execute(fork_worker& w)
+    {
+        this->run(w);
+        std::lock_guard<std::mutex> lock(m);
+        this->done.store(true, std::memory_order_release);
+        cv.notify_one();
+    }
+
+    R wait()
+    {
+        std::unique_lock<std::mutex> lock(m);
+        while (!this->done.load(std::memory_order_acquire)) cv.wait(lock);
+        return this->get();
+    }
+};
+
+// Joins a task that refers to the stack before the stack is unwound
+struct fork_join_guard
+{
+    fork_scheduler * scheduler;
+    fork_worker * worker;
+    fork_task * task;
+
+    ~fork_join_guard()
+    {
+        scheduler->join(*worker, *task);
+    }
+};
+
+inline fork_scheduler& default_fork_scheduler()
+{
+    static fork_scheduler s(std::thread::hardware_concurrency());
+    return s;
+}
+
+struct fix_parallel_f;
+
+}
+
+class fork_join_pool
+{
+    detail::fork_scheduler s;
+    friend struct detail::fix_parallel_f;
+public:
+    explicit fork_join_pool(std::size_t threads=std::thread::hardware_concurrency()) : s(threads)
+    {}
+
+    std::size_t size() const
+    {
+        return s.size();
+    }
+};
+
+template<class Adaptor, class F>
+struct fix_parallel_self
+{
+    const Adaptor * a;
+    detail::fork_scheduler * scheduler;
+    detail::fork_worker * worker;
+    int depth;
+
+    template<class... Ts>
+    typename detail::fix_parallel_result<F, Ts&&...>::type
+    operator()(Ts&&... xs) const
+    {
+        return a->invoke(depth + 1, *scheduler, *worker, FIT_FORWARD(Ts)(xs)...);
+    }
+
+    template<class T>
+    std::tuple<typename detail::fix_parallel_result<F, T&&>::type>
+    fork(T&& x) const
+    {
+        return std::tuple<typename detail::fix_parallel_result<F, T&&>::type>((*this)(FIT_FORWARD(T)(x)));
+    }
+
+    template<class T, class U, class... Ts>
+    std::tuple<
+        typename detail::fix_parallel_result<F, T&&>::type,
+        typename detail::fix_parallel_result<F, U&&>::type,
+        typename detail::fix_parallel_result<F, Ts&&>::type...
+    >
+    fork(T&& x, U&& y, Ts&&... xs) const
+    {
+        typedef typename detail::fix_parallel_result<F, T&&>::type first_type;
+        typedef std::tuple<
+            typename detail::fix_parallel_result<F, U&&>::type,
+            typename detail::fix_parallel_result<F, Ts&&>::type...
+        > rest_type;
+        typedef decltype(fit::pack_forward(FIT_FORWARD(U)(y), FIT_FORWARD(Ts)(xs)...)) pack_type;
+        // The rest of the calls are forked by whoever takes the task
+        detail::fork_branch<detail::fork_call_rest, fix_parallel_self, pack_type, rest_type> rest(
+            *this, fit::pack_forward(FIT_FORWARD(U)(y), FIT_FORWARD(Ts)(xs)...)
+        );
+        detail::fork_result<first_type> first;
+        scheduler->push(*worker, rest);
+        {
+            detail::fork_join_guard join = { scheduler, worker, &rest };
+            first.set((*this)(FIT_FORWARD(T)(x)));
+        }
+        return std::tuple_cat(std::tuple<first_type>(first.take()), rest.get());
+    }
+};
+
+#else
+
+// Every call is serial, so the pool has no threads
+class fork_join_pool
+{
+public:
+    explicit fork_join_pool(std::size_t=1)
+    {}
+
+    std::size_t size() const
+    {
+        return 1;
+    }
+};
+
+#endif
+
+template<class F, class Cutoff>
+struct fix_parallel_adaptor : detail::compressed_pair<detail::callable_base<F>, Cutoff>
+{
+    typedef detail::compressed_pair<detail::callable_base<F>, Cutoff> base;
+    typedef fix_serial_self<detail::callable_base<F>> serial_self;
+#if !FIT_SINGLE_THREADED
+    typedef fix_parallel_self<fix_parallel_adaptor, detail::callable_base<F>> parallel_self;
+    detail::fork_scheduler * scheduler;
+
+    template<class X, class Y>
+    fix_parallel_adaptor(X&& f, Y&& cutoff, detail::fork_scheduler * s=nullptr)
+    : base(FIT_FORWARD(X)(f), FIT_FORWARD(Y)(cutoff)), scheduler(s)
+    {}
+#else
+    FIT_INHERIT_CONSTRUCTOR(fix_parallel_adaptor, base)
+#endif
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr const Cutoff& base_cutoff(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+#if !FIT_SINGLE_THREADED
+    template<class... Ts>
+    typename detail::fix_parallel_result<detail::callable_base<F>, Ts&&...>::type
+    invoke(int depth, detail::fork_scheduler& s, detail::fork_worker& w, Ts&&... xs) const
+    {
+        const detail::callable_base<F>& f = this->base_function(xs...);
+        if (detail::fix_parallel_is_serial(this->base_cutoff(xs...), depth, xs...))
+            return f(serial_self(f), FIT_FORWARD(Ts)(xs)...);
+        parallel_self self = { this, &s, &w, depth };
+        return f(self, FIT_FORWARD(Ts)(xs)...);
+    }
+#endif
+
+    template<class... Ts, class=typename std::enable_if<(
+        fit::is_callable<const detail::callable_base<F>&, serial_self, Ts&&...>::value
+    )>::type>
+    typename detail::fix_parallel_result<detail::callable_base<F>, Ts&&...>::type
+    operator()(Ts&&... xs) const
+    {
+        const detail::callable_base<F>& f = this->base_function(xs...);
+#if !FIT_SINGLE_THREADED
+        typedef typename detail::fix_parallel_result<detail::callable_base<F>, Ts&&...>::type result_type;
+        // Small problems don't need the pool at all
+        if (!detail::fix_parallel_is_serial(this->base_cutoff(xs...), 0, xs...))
+        {
+            detail::fork_scheduler& s = scheduler != nullptr ? *scheduler : detail::default_fork_scheduler();
+            detail::fork_worker * w = detail::fork_current_worker();
+            parallel_self self = { this, &s, w, -1 };
+            if (s.owns(w)) return self(FIT_FORWARD(Ts)(xs)...);
+            typedef decltype(fit::pack_forward(FIT_FORWARD(Ts)(xs)...)) pack_type;
+            detail::fork_root<parallel_self, pack_type, result_type> root(self, fit::pack_forward(FIT_FORWARD(Ts)(xs)...));
+            s.submit(root);
+            return root.wait();
+        }
+#endif
+        return f(serial_self(f), FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+namespace detail {
+
+struct fix_parallel_f
+{
+    template<class F, class Cutoff>
+    fix_parallel_adaptor<F, Cutoff> operator()(F f, Cutoff cutoff) const
+    {
+        return fix_parallel_adaptor<F, Cutoff>(fit::move(f), fit::move(cutoff));
+    }
+
+#if !FIT_SINGLE_THREADED
+    template<class F, class Cutoff>
+    fix_parallel_adaptor<F, Cutoff> operator()(F f, Cutoff cutoff, fork_join_pool& pool) const
+    {
+        return fix_parallel_adaptor<F, Cutoff>(fit::move(f), fit::move(cutoff), &pool.s);
+    }
+#else
+    template<class F, class Cutoff>
+    fix_parallel_adaptor<F, Cutoff> operator()(F f, Cutoff cutoff, fork_join_pool&) const
+    {
+        return fix_parallel_adaptor<F, Cutoff>(fit::move(f), fit::move(cutoff));
+    }
+#endif
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(fix_parallel, detail::fix_parallel_f);
+
+} // namespace fit
+
+#endif
@@ -0,0 +1,673 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    fix_stackless.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_FIX_STACKLESS_H
+#define FIT_GUARD_FUNCTION_FIX_STACKLESS_H
+
+/// fix_stackless
+/// =============
+///
+/// Description
+/// -----------
+///
+/// The `fix_stackless` function adaptor is a fixed-point combinator, like
+/// [`fix`](/include/fit/fix), for recursions that are too deep for the
+/// stack, such as folding a degenerate tree. The recursion is not run on the
+/// stack. Instead, calling `self` returns a `stackless_frame<R>`, which is a
+/// suspended call, and the result of the call is used by attaching a
+/// continuation with `then`:
+///
+///     return self(n->left).then([=](int l) { return l + n->value; });
+///
+/// A continuation can return an `R` or another frame. The function itself
+/// returns a frame as well, which can also be built directly from a value.
+/// The adaptor then runs the frames in a loop, keeping the pending
+/// continuations on a stack on the heap, so the depth of the recursion is
+/// only limited by memory. The continuations are allocated from a pool that
+/// is reused while the recursion runs, and freed when it returns. When a
+/// call or a continuation throws, the pending continuations are destroyed
+/// without running, and the exception leaves the adaptor.
+///
+/// When the compiler supports coroutines, the function can be a coroutine
+/// that returns a `stackless_frame<R>` and awaits the frames instead:
+///
+///     int l = co_await self(n->left);
+///
+/// The arguments of a call to `self` are decayed and stored in the frame until
+/// the call runs. `R` is the result of every call to the function, and must be
+/// DefaultConstructible and MoveConstructible.
+///
+/// Synopsis
+/// --------
+///
+///     template<class R, class F>
+///     constexpr fix_stackless_adaptor<R, F> fix_stackless(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(fix_stackless<R>(f)(xs...) == fix(g)(xs...));
+///
+/// Where `g` is `f` with every frame replaced by the value it computes.
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [ConstFunctionObject](ConstFunctionObject)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///
+///     struct add_one
+///     {
+///         long operator()(long x) const
+///         {
+///             return x + 1;
+///         }
+///     };
+///
+///     struct depth
+///     {
+///         template<class Self>
+///         fit::stackless_frame<long> operator()(Self self, long n) const
+///         {
+///             if (n == 0) return 0;
+///             return self(n - 1).then(add_one());
+///         }
+///     };
+///
+///     int main() {
+///         long r = fit::fix_stackless<long>(depth())(1000000);
+///         assert(r == 1000000);
+///     }
+///
+
+#include <fit/pack.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/always.hpp>
+#include <fit/is_callable.hpp>
+#include <fit/returns.hpp>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+#if FIT_HAS_COROUTINES
+#include <coroutine>
+#include <exception>
+#endif
+
+namespace fit {
+
+template<class R>
+class stackless_frame;
+
+namespace detail {
+
+// Allocates small blocks from chunks, and keeps freed blocks in a list for
+// each size, so the frames of a recursion reuse the same memory
+class stackless_pool
+{
+    static const std::size_t granule = 16;
+    static const std::size_t classes = 16;
+    static const std::size_t chunk_size = 64*1024;
+
+    void * free_lists[classes];
+    void * chunks;
+    unsigned char * pos;
+    unsigned char * last;
+
+    void grow()
+    {
+        unsigned char * chunk = static_cast<unsigned char*>(::operator new(chunk_size));
+        *reinterpret_cast<void**>(chunk) = chunks;
+        chunks = chunk;
+        pos = chunk + granule;
+        last = chunk + chunk_size;
+    }
+public:
+    stackless_pool() : chunks(nullptr), pos(nullptr), last(nullptr)
+    {
+        for(std::size_t i=0;i<classes;i++) free_lists[i] = nullptr;
+    }
+
+    stackless_pool(const stackless_pool&) = delete;
+    stackless_pool& operator=(const stackless_pool&) = delete;
+
+    ~stackless_pool()
+    {
+        while(chunks != nullptr)
+        {
+            void * next = *static_cast<void**>(chunks);
+            ::operator delete(chunks);
+            chunks = next;
+        }
+    }
+
+    void * allocate(std::size_t n)
+    {
+        std::size_t c = (n + granule - 1) / granule;
+        if (c == 0) c = 1;
+        if (c > classes) return ::operator new(n);
+        void *& head = free_lists[c - 1];
+        if (head != nullptr)
+        {
+            void * p = head;
+            head = *static_cast<void**>(p);
+            return p;
+        }
+        if (std::size_t(last - pos) < c*granule) this->grow();
+        void * p = pos;
+        pos += c*granule;
+        return p;
+    }
+
+    void deallocate(void * p, std::size_t n)
+    {
+        std::size_t c = (n + granule - 1) / granule;
+        if (c == 0) c = 1;
+        if (c > classes) return ::operator delete(p);
+        void *& head = free_lists[c - 1];
+        *static_cast<void**>(p) = head;
+        head = p;
+    }
+};
+
+#if FIT_HAS_COROUTINES
+// Coroutine frames are allocated from the pool of the recursion that is
+// running on this thread
+inline stackless_pool *& stackless_current_pool()
+{
+    static thread_local stackless_pool * pool = nullptr;
+    return pool;
+}
+
+struct stackless_pool_scope
+{
+    stackless_pool * previous;
+
+    stackless_pool_scope(stackless_pool& pool) : previous(stackless_current_pool())
+    {
+        stackless_current_pool() = &pool;
+    }
+
+    stackless_pool_scope(const stackless_pool_scope&) = delete;
+    stackless_pool_scope& operator=(const stackless_pool_scope&) = delete;
+
+    ~stackless_pool_scope()
+    {
+        stackless_current_pool() = previous;
+    }
+};
+#endif
+
+// A suspended call or continuation. The stack of pending continuations is
+// linked through the nodes.
+template<class R>
+struct stackless_node
+{
+    stackless_node * next;
+
+    stackless_node() : next(nullptr)
+    {}
+
+    // Runs the node, with the result of the previous frame for
+    // continuations, and frees it unless it is suspended again
+    virtual stackless_frame<R> run(stackless_pool& pool, R * value) = 0;
+
+    // Frees the node without running it
+    virtual void discard(stackless_pool& pool) = 0;
+protected:
+    ~stackless_node()
+    {}
+};
+
+template<class Node>
+void stackless_free(Node * n, stackless_pool& pool)
+{
+    n->~Node();
+    pool.deallocate(n, sizeof(Node));
+}
+
+template<class R, class K>
+struct stackless_then : stackless_node<R>
+{
+    K k;
+
+    template<class X>
+    stackless_then(X&& x) : k(FIT_FORWARD(X)(x))
+    {}
+
+    stackless_frame<R> run(stackless_pool& pool, R * value)
+    {
+        K f = fit::move(k);
+        detail::stackless_free(this, pool);
+        return stackless_frame<R>(f(fit::move(*value)));
+    }
+
+    void discard(stackless_pool& pool)
+    {
+        detail::stackless_free(this, pool);
+    }
+};
+
+template<class Self>
+struct stackless_invoke
+{
+    Self self;
+
+    template<class... Ts>
+    auto operator()(Ts&&... xs) const FIT_RETURNS
+    (
+        self.function()(self, FIT_FORWARD(Ts)(xs)...)
+    );
+};
+
+template<class R, class Self, class Pack>
+struct stackless_call : stackless_node<R>
+{
+    Self self;
+    Pack args;
+
+    template<class P>
+    stackless_call(const Self& s, P&& p) : self(s), args(FIT_FORWARD(P)(p))
+    {}
+
+    stackless_frame<R> run(stackless_pool& pool, R *)
+    {
+        stackless_invoke<Self> f = { self };
+        Pack a = fit::move(args);
+        detail::stackless_free(this, pool);
+        return stackless_frame<R>(a(f));
+    }
+
+    void discard(stackless_pool& pool)
+    {
+        detail::stackless_free(this, pool);
+    }
+};
+
+template<class R>
+R stackless_run(stackless_frame<R> frame, stackless_pool& pool);
+
+}
+
+template<class R>
+class stackless_frame
+{
+    static_assert(!std::is_reference<R>::value && !std::is_void<R>::value, "A stackless recursion must return a value");
+
+    typedef detail::stackless_node<R> node;
+
+    node * call;
+    // Continuations that run after the call, in order
+    node * first;
+    node * last;
+    detail::stackless_pool * pool;
+    R value;
+#if FIT_HAS_COROUTINES
+    R * slot;
+#endif
+
+    template<class T>
+    friend T detail::stackless_run(stackless_frame<T>, detail::stackless_pool&);
+
+    template<class, class>
+    friend class stackless_self;
+
+    void push_back(node * n)
+    {
+        if (last == nullptr) first = n;
+        else last->next = n;
+        last = n;
+    }
+
+    void clear()
+    {
+        if (call != nullptr) call->discard(*pool);
+        while(first != nullptr)
+        {
+            node * n = first;
+            first = n->next;
+            n->discard(*pool);
+        }
+        call = nullptr;
+        last = nullptr;
+    }
+
+    void take(stackless_frame& rhs)
+    {
+        call = rhs.call;
+        first = rhs.first;
+        last = rhs.last;
+        pool = rhs.pool;
+        value = fit::move(rhs.value);
+        rhs.call = nullptr;
+        rhs.first = nullptr;
+        rhs.last = nullptr;
+    }
+
+    stackless_frame(node * c, detail::stackless_pool * p)
+    : call(c), first(nullptr), last(nullptr), pool(p), value()
+#if FIT_HAS_COROUTINES
+    , slot(nullptr)
+#endif
+    {}
+public:
+    template<class T, typename std::enable_if<(
+        std::is_convertible<T, R>::value && !std::is_same<typename std::decay<T>::type, stackless_frame>::value
+    ), int>::type = 0>
+    stackless_frame(T&& x)
+    : call(nullptr), first(nullptr), last(nullptr), pool(nullptr), value(FIT_FORWARD(T)(x))
+#if FIT_HAS_COROUTINES
+    , slot(nullptr)
+#endif
+    {}
+
+    stackless_frame(stackless_frame&& rhs)
+#if FIT_HAS_COROUTINES
+    : slot(nullptr)
+#endif
+    {
+        this->take(rhs);
+    }
+
+    stackless_frame& operator=(stackless_frame&& rhs)
+    {
+        if (this != &rhs)
+        {
+            this->clear();
+            this->take(rhs);
+        }
+        return *this;
+    }
+
+    stackless_frame(const stackless_frame&) = delete;
+    stackless_frame& operator=(const stackless_frame&) = delete;
+
+    ~stackless_frame()
+    {
+        this->clear();
+    }
+
+    template<class K>
+    stackless_frame then(K k) &&
+    {
+        if (call == nullptr) return stackless_frame(k(fit::move(value)));
+        typedef detail::stackless_then<R, K> then_node;
+        this->push_back(new (pool->allocate(sizeof(then_node))) then_node(fit::move(k)));
+        return stackless_frame(fit::move(*this));
+    }
+
+#if FIT_HAS_COROUTINES
+    struct promise_type;
+
+    bool await_ready() const noexcept
+    {
+        return call == nullptr;
+    }
+
+    void await_suspend(std::coroutine_handle<promise_type> h);
+
+    R await_resume()
+    {
+        return fit::move(slot == nullptr ? value : *slot);
+    }
+#endif
+};
+
+#if FIT_HAS_COROUTINES
+template<class R>
+struct stackless_frame<R>::promise_type : detail::stackless_node<R>
+{
+    typedef std::coroutine_handle<promise_type> handle;
+
+    detail::stackless_pool * pool;
+    R result;
+    R awaited;
+    stackless_frame<R> child;
+    std::exception_ptr error;
+
+    promise_type() : pool(detail::stackless_current_pool()), result(), awaited(), child(R())
+    {}
+
+    // The pool is stored before the coroutine frame, so it can be freed
+    // without the promise
+    static void * operator new(std::size_t n)
+    {
+        detail::stackless_pool * p = detail::stackless_current_pool();
+        const std::size_t header = 16;
+        unsigned char * b = static_cast<unsigned char*>(p == nullptr ? ::operator new(n + header) : p->allocate(n + header));
+        *reinterpret_cast<detail::stackless_pool**>(b) = p;
+        return b + header;
+    }
+
+    static void operator delete(void * ptr, std::size_t n)
+    {
+        const std::size_t header = 16;
+        unsigned char * b = static_cast<unsigned char*>(ptr) - header;
+        detail::stackless_pool * p = *reinterpret_cast<detail::stackless_pool**>(b);
+        if (p == nullptr) ::operator delete(b);
+        else p->deallocate(b, n + header);
+    }
+
+    stackless_frame<R> get_return_object()
+    {
+        return stackless_frame<R>(this, pool);
+    }
+
+    std::suspend_always initial_suspend() noexcept
+    {
+        return {};
+    }
+
+    std::suspend_always final_suspend() noexcept
+    {
+        return {};
+    }
+
+    template<class T>
+    void return_value(T&& x)
+    {
+        result = FIT_FORWARD(T)(x);
+    }
+
+    // The exception is rethrown by run, so it leaves the recursion the same
+    // way as an exception from a function that isn't a coroutine
+    void unhandled_exception()
+    {
+        error = std::current_exception();
+    }
+
+    stackless_frame<R> run(detail::stackless_pool&, R * value)
+    {
+        if (value != nullptr) awaited = fit::move(*value);
+        handle h = handle::from_promise(*this);
+        h.resume();
+        if (h.done())
+        {
+            if (error)
+            {
+                std::exception_ptr e = error;
+                h.destroy();
+                std::rethrow_exception(e);
+            }
+            R r = fit::move(result);
+            h.destroy();
+            return stackless_frame<R>(fit::move(r));
+        }
+        // The coroutine is waiting for the child, so it runs again after it
+        stackless_frame<R> c = fit::move(child);
+        c.push_back(this);
+        return c;
+    }
+
+    void discard(detail::stackless_pool&)
+    {
+        handle::from_promise(*this).destroy();
+    }
+};
+
+template<class R>
+void stackless_frame<R>::await_suspend(std::coroutine_handle<promise_type> h)
+{
+    promise_type& p = h.promise();
+    p.child = fit::move(*this);
+    slot = &p.awaited;
+}
+#endif
+
+template<class R, class F>
+class stackless_self
+{
+    const F * f;
+    detail::stackless_pool * pool;
+public:
+    stackless_self(const F& fun, detail::stackless_pool& p) : f(&fun), pool(&p)
+    {}
+
+    const F& function() const
+    {
+        return *f;
+    }
+
+    template<class... Ts>
+    stackless_frame<R> operator()(Ts&&... xs) const
+    {
+        typedef decltype(fit::pack_decay(FIT_FORWARD(Ts)(xs)...)) pack_type;
+        typedef detail::stackless_call<R, stackless_self, pack_type> call_node;
+        void * p = pool->allocate(sizeof(call_node));
+        return stackless_frame<R>(new (p) call_node(*this, fit::pack_decay(FIT_FORWARD(Ts)(xs)...)), pool);
+    }
+};
+
+namespace detail {
+
+// Discards the pending continuations when the recursion throws
+template<class R>
+struct stackless_stack
+{
+    stackless_node<R> * top;
+    stackless_pool * pool;
+
+    explicit stackless_stack(stackless_pool& p) : top(nullptr), pool(&p)
+    {}
+
+    stackless_stack(const stackless_stack&) = delete;
+    stackless_stack& operator=(const stackless_stack&) = delete;
+
+    ~stackless_stack()
+    {
+        while(top != nullptr)
+        {
+            stackless_node<R> * n = top;
+            top = n->next;
+            n->discard(*pool);
+        }
+    }
+};
+
+template<class R>
+R stackless_run(stackless_frame<R> frame, stackless_pool& pool)
+{
+    stackless_stack<R> pending(pool);
+    stackless_node<R> *& stack = pending.top;
+    for(;;)
+    {
+        if (frame.call != nullptr)
+        {
+            // The continuations of the frame run after its call
+            if (frame.first != nullptr)
+            {
+                frame.last->next = stack;
+                stack = frame.first;
+                frame.first = nullptr;
+                frame.last = nullptr;
+            }
+            stackless_node<R> * c = frame.call;
+            frame.call = nullptr;
+            frame = c->run(pool, nullptr);
+        }
+        else if (stack == nullptr)
+        {
+            return fit::move(frame.value);
+        }
+        else
+        {
+            stackless_node<R> * k = stack;
+            stack = k->next;
+            k->next = nullptr;
+            frame = k->run(pool, &frame.value);
+        }
+    }
+}
+
+}
+
+template<class R, class F>
+struct fix_stackless_adaptor : detail::callable_base<F>
+{
+    FIT_INHERIT_CONSTRUCTOR(fix_stackless_adaptor, detail::callable_base<F>)
+
+    typedef R result_type;
+    typedef stackless_self<R, detail::callable_base<F>> self_type;
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return always_ref(*this)(xs...);
+    }
+
+    template<class... Ts, class=typename std::enable_if<(
+        fit::is_callable<const detail::callable_base<F>&, const self_type&, typename std::decay<Ts>::type&...>::value
+    )>::type>
+    R operator()(Ts&&... xs) const
+    {
+        detail::stackless_pool pool;
+#if FIT_HAS_COROUTINES
+        detail::stackless_pool_scope scope(pool);
+#endif
+        self_type self(this->base_function(xs...), pool);
+        return detail::stackless_run<R>(self(FIT_FORWARD(Ts)(xs)...), pool);
+    }
+};
+
+#if FIT_HAS_VARIABLE_TEMPLATES
+namespace fix_stackless_detail {
+template<class R>
+struct fix_stackless_f
+{
+    template<class F>
+    constexpr fix_stackless_adaptor<R, F> operator()(F f) const
+    {
+        return fix_stackless_adaptor<R, F>(fit::move(f));
+    }
+};
+
+}
+
+template<class R>
+static constexpr auto fix_stackless = fix_stackless_detail::fix_stackless_f<R>{};
+#else
+template<class R, class F>
+constexpr fix_stackless_adaptor<R, F> fix_stackless(F f)
+{
+    return fix_stackless_adaptor<R, F>(fit::move(f));
+}
+#endif
+
+} // namespace fit
+
+#endif
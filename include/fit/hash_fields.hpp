@@ -0,0 +1,402 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    hash_fields.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_HASH_FIELDS_H
+#define FIT_GUARD_HASH_FIELDS_H
+
+/// hash_fields
+/// ===========
+///
+/// Description
+/// -----------
+///
+/// The `hash_fields` function hashes a value from its fields. A sequence
+/// that can be [unpacked](/include/fit/unpack), such as a `std::tuple`, a
+/// [`pack`](/include/fit/pack), or a type with an
+/// [`unpack_sequence`](/include/fit/unpack_sequence) specialisation, is
+/// hashed by folding each of its fields into the hash with
+/// [`compress`](/include/fit/compress). Nested sequences are hashed the
+/// same way. Each field is hashed depending on its type:
+///
+/// * Integers, enums, pointers and floating point numbers are packed
+///   together into 64-bit words, so several small fields that follow each
+///   other are mixed into the hash only once.
+/// * A trivially copyable type without padding bits, such as a struct of
+///   integers, is hashed from its bytes, eight at a time, unless it is a
+///   range, or it has a `std::hash` specialisation or an `operator==`. Such
+///   a type may consider values with different bytes equal, so it uses
+///   `std::hash` instead, and a type with only an `operator==` must be made
+///   a sequence or given a `std::hash` specialisation to be hashed.
+/// * A contiguous range of such elements, such as `std::string`,
+///   `std::string_view` or `std::vector<int>`, is hashed from its size and
+///   the bytes of its elements, so equal views of different buffers have the
+///   same hash.
+/// * An empty type is skipped.
+/// * Any other type uses `std::hash`, or if it's not available, each element
+///   of the range is hashed one after another.
+///
+/// Whether a type has padding bits can only be checked on compilers with
+/// `__has_unique_object_representations`. Elsewhere, structs are only hashed
+/// when they are sequences or have a `std::hash` specialisation.
+///
+/// The `field_hash` class can be used as the hash of an unordered container.
+/// The hash isn't guaranteed to be the same across platforms or versions
+/// of the library.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T>
+///     std::size_t hash_fields(const T& x);
+///
+/// Requirements
+/// ------------
+///
+/// T must be:
+///
+/// * An unpackable sequence of hashable fields, or a hashable field
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <string>
+///     #include <tuple>
+///     #include <unordered_set>
+///
+///     int main() {
+///         std::unordered_set<std::tuple<std::string, int, short>, fit::field_hash> s;
+///         s.insert(std::make_tuple("x", 1, short(2)));
+///         assert(s.count(std::make_tuple("x", 1, short(2))) == 1);
+///         assert(fit::hash_fields(std::make_tuple(1, 2)) != fit::hash_fields(std::make_tuple(2, 1)));
+///     }
+///
+
+#include <fit/compress.hpp>
+#include <fit/conditional.hpp>
+#include <fit/is_callable.hpp>
+#include <fit/is_unpackable.hpp>
+#include <fit/unpack.hpp>
+#include <fit/detail/contiguous.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/intrinsics.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace fit {
+
+namespace detail {
+
+struct hash_state
+{
+    std::uint64_t h;
+    // Small fields are collected here until the word is full
+    std::uint64_t word;
+    unsigned bits;
+
+    hash_state() : h(0x243F6A8885A308D3ull), word(0), bits(0)
+    {}
+};
+
+constexpr std::uint64_t hash_rotate(std::uint64_t x, int r)
+{
+    return (x << r) | (x >> (64 - r));
+}
+
+constexpr std::uint64_t hash_mix(std::uint64_t h, std::uint64_t x)
+{
+    return (hash_rotate(h, 27) ^ x) * 0x9E3779B97F4A7C15ull;
+}
+
+constexpr std::uint64_t hash_xor_shift(std::uint64_t x)
+{
+    return x ^ (x >> 33);
+}
+
+// The murmur3 finalizer, so every bit of the input affects every bit of
+// the result
+constexpr std::uint64_t hash_avalanche(std::uint64_t x)
+{
+    return hash_xor_shift(hash_xor_shift(hash_xor_shift(x) * 0xFF51AFD7ED558CCDull) * 0xC4CEB9FE1A85EC53ull);
+}
+
+inline void hash_flush(hash_state& s)
+{
+    if (s.bits != 0)
+    {
+        s.h = hash_mix(s.h, s.word);
+        s.word = 0;
+        s.bits = 0;
+    }
+}
+
+template<std::size_t Size>
+inline hash_state hash_push(hash_state s, std::uint64_t w)
+{
+    static_assert(Size > 0 && Size <= 8, "Only words up to 64 bits can be pushed");
+    if (s.bits + Size*8 > 64) hash_flush(s);
+    s.word |= w << s.bits;
+    s.bits += Size*8;
+    return s;
+}
+
+inline std::uint64_t hash_load(const unsigned char * p)
+{
+    std::uint64_t w;
+    std::memcpy(&w, p, 8);
+    return w;
+}
+
+inline std::uint64_t hash_bytes(std::uint64_t h, const void * data, std::size_t n)
+{
+    const unsigned char * p = static_cast<const unsigned char*>(data);
+    // Four independent lanes, so the multiplies don't wait on each other
+    if (n >= 32)
+    {
+        std::uint64_t a = h;
+        std::uint64_t b = h ^ 0x452821E638D01377ull;
+        std::uint64_t c = h ^ 0xBE5466CF34E90C6Cull;
+        std::uint64_t d = h ^ 0xC0AC29B7C97C50DDull;
+        for(;n >= 32;p += 32, n -= 32)
+        {
+            a = hash_mix(a, hash_load(p));
+            b = hash_mix(b, hash_load(p + 8));
+            c = hash_mix(c, hash_load(p + 16));
+            d = hash_mix(d, hash_load(p + 24));
+        }
+        h = hash_mix(hash_mix(hash_mix(a, b), c), d);
+    }
+    for(;n >= 8;p += 8, n -= 8) h = hash_mix(h, hash_load(p));
+    if (n > 0)
+    {
+        std::uint64_t w = 0;
+        std::memcpy(&w, p, n);
+        h = hash_mix(h, w);
+    }
+    return h;
+}
+
+template<class T>
+struct hash_is_word
+: std::integral_constant<bool, (
+    (std::is_arithmetic<T>::value || std::is_enum<T>::value || std::is_pointer<T>::value) && sizeof(T) <= 8
+)>
+{};
+
+template<class T, class=void>
+struct hash_is_range
+: std::false_type
+{};
+
+template<class T>
+struct hash_is_range<T, typename holder<
+    decltype(std::begin(std::declval<const T&>()))
+>::type>
+: std::true_type
+{};
+
+template<class T, class=void>
+struct hash_has_std
+: std::false_type
+{};
+
+template<class T>
+struct hash_has_std<T, typename holder<
+    decltype(std::hash<T>()(std::declval<const T&>()))
+>::type>
+: std::true_type
+{};
+
+template<class T, class=void>
+struct hash_has_equal
+: std::false_type
+{};
+
+template<class T>
+struct hash_has_equal<T, typename holder<
+    decltype(std::declval<const T&>() == std::declval<const T&>())
+>::type>
+: std::true_type
+{};
+
+// Ranges are left out, since a view, such as `std::string_view`, has no
+// padding but holds a pointer, and equal views can point to different
+// buffers. A class with its own `std::hash` or `operator==` may compare
+// values with different bytes as equal, so only plain structs are used.
+template<class T>
+struct hash_is_bytes
+: std::integral_constant<bool, (
+    FIT_IS_TRIVIALLY_COPYABLE(T) && FIT_HAS_UNIQUE_REPRESENTATION(T) && !hash_is_range<T>::value &&
+    (std::is_scalar<T>::value || (!hash_has_std<T>::value && !hash_has_equal<T>::value))
+)>
+{};
+
+template<class T, class=void>
+struct hash_word_type
+{
+    typedef typename std::make_unsigned<T>::type type;
+};
+
+template<class T>
+struct hash_word_type<T, typename std::enable_if<std::is_enum<T>::value>::type>
+: hash_word_type<typename std::underlying_type<T>::type>
+{};
+
+template<>
+struct hash_word_type<bool>
+{
+    typedef unsigned char type;
+};
+
+template<class T, typename std::enable_if<(std::is_integral<T>::value || std::is_enum<T>::value), int>::type = 0>
+inline std::uint64_t hash_word(T x)
+{
+    return static_cast<typename hash_word_type<T>::type>(x);
+}
+
+template<class T, typename std::enable_if<(std::is_pointer<T>::value), int>::type = 0>
+inline std::uint64_t hash_word(T x)
+{
+    return reinterpret_cast<std::uintptr_t>(x);
+}
+
+template<class T, typename std::enable_if<(std::is_floating_point<T>::value), int>::type = 0>
+inline std::uint64_t hash_word(T x)
+{
+    // Both zeros compare equal, so they need the same hash
+    if (x == 0) return 0;
+    std::uint64_t w = 0;
+    std::memcpy(&w, &x, sizeof(T));
+    return w;
+}
+
+struct hash_step;
+
+struct hash_field_word
+{
+    template<class T, class=typename std::enable_if<hash_is_word<T>::value>::type>
+    hash_state operator()(hash_state s, const T& x) const
+    {
+        return detail::hash_push<sizeof(T)>(s, detail::hash_word(x));
+    }
+};
+
+struct hash_field_bytes
+{
+    template<class T, class=typename std::enable_if<(hash_is_bytes<T>::value && !std::is_empty<T>::value)>::type>
+    hash_state operator()(hash_state s, const T& x) const
+    {
+        detail::hash_flush(s);
+        s.h = detail::hash_bytes(s.h, &x, sizeof(T));
+        return s;
+    }
+};
+
+struct hash_field_unpack
+{
+    template<class T, class=typename std::enable_if<is_unpackable<T>::value>::type, class=typename std::enable_if<
+        is_callable<unpack_adaptor<compress_adaptor<hash_step, hash_state>>, const T&>::value
+    >::type>
+    hash_state operator()(hash_state s, const T& x) const
+    {
+        return fit::unpack(fit::compress(hash_step(), s))(x);
+    }
+};
+
+struct hash_field_empty
+{
+    template<class T, class=typename std::enable_if<std::is_empty<T>::value>::type>
+    hash_state operator()(hash_state s, const T&) const
+    {
+        return s;
+    }
+};
+
+struct hash_field_contiguous
+{
+    template<class T, class E=typename contiguous_element<T>::type, class=typename std::enable_if<(
+        hash_is_word<E>::value && !std::is_floating_point<E>::value) || hash_is_bytes<E>::value
+    >::type>
+    hash_state operator()(hash_state s, const T& x) const
+    {
+        detail::hash_flush(s);
+        std::size_t n = detail::contiguous_size(x);
+        s.h = detail::hash_mix(s.h, n);
+        s.h = detail::hash_bytes(s.h, detail::contiguous_data(x), n*sizeof(E));
+        return s;
+    }
+};
+
+struct hash_field_std
+{
+    template<class T, class=typename std::enable_if<std::is_convertible<
+        decltype(std::hash<T>()(std::declval<const T&>())), std::size_t
+    >::value>::type>
+    hash_state operator()(hash_state s, const T& x) const
+    {
+        detail::hash_flush(s);
+        s.h = detail::hash_mix(s.h, std::hash<T>()(x));
+        return s;
+    }
+};
+
+struct hash_field_range
+{
+    template<class T, class E=decltype(*std::begin(std::declval<const T&>())), class=typename std::enable_if<
+        is_callable<hash_step, hash_state, E>::value
+    >::type>
+    hash_state operator()(hash_state s, const T& x) const
+    {
+        std::uint64_t n = 0;
+        for(auto&& e:x)
+        {
+            s = hash_step()(s, e);
+            ++n;
+        }
+        detail::hash_flush(s);
+        s.h = detail::hash_mix(s.h, n);
+        return s;
+    }
+};
+
+struct hash_step
+: conditional_adaptor<
+    hash_field_word,
+    hash_field_bytes,
+    hash_field_unpack,
+    hash_field_empty,
+    hash_field_contiguous,
+    hash_field_std,
+    hash_field_range
+>
+{};
+
+}
+
+struct field_hash
+{
+    template<class T, class=typename std::enable_if<is_callable<detail::hash_step, detail::hash_state, const T&>::value>::type>
+    std::size_t operator()(const T& x) const
+    {
+        detail::hash_state s = detail::hash_step()(detail::hash_state(), x);
+        detail::hash_flush(s);
+        return static_cast<std::size_t>(detail::hash_avalanche(s.h));
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(hash_fields, field_hash);
+
+} // namespace fit
+
+#endif
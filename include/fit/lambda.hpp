@@ -69,6 +69,26 @@
 #include <fit/function.hpp>
 
 
+// Constexpr lambdas and inline variables let the lambda be used directly,
+// without the static_function_wrapper or rewriting the lambda type. The
+// lambda from FIT_STATIC_LAMBDA also needs to be default constructible, just
+// like the static_function_wrapper.
+#ifndef FIT_HAS_DIRECT_STATIC_LAMBDA_FUNCTION
+#if FIT_HAS_CONSTEXPR_LAMBDA && FIT_HAS_INLINE_VARIABLES
+#define FIT_HAS_DIRECT_STATIC_LAMBDA_FUNCTION 1
+#else
+#define FIT_HAS_DIRECT_STATIC_LAMBDA_FUNCTION 0
+#endif
+#endif
+
+#ifndef FIT_HAS_DIRECT_STATIC_LAMBDA
+#if FIT_HAS_DIRECT_STATIC_LAMBDA_FUNCTION && FIT_HAS_DEFAULT_CONSTRUCTIBLE_LAMBDA
+#define FIT_HAS_DIRECT_STATIC_LAMBDA 1
+#else
+#define FIT_HAS_DIRECT_STATIC_LAMBDA 0
+#endif
+#endif
+
 #ifndef FIT_REWRITE_STATIC_LAMBDA
 #ifdef _MSC_VER
 #define FIT_REWRITE_STATIC_LAMBDA 1
@@ -81,6 +101,21 @@ namespace fit {
 
 namespace detail {
 
+#if FIT_HAS_DIRECT_STATIC_LAMBDA_FUNCTION
+struct reveal_static_lambda_factory
+{
+    constexpr reveal_static_lambda_factory()
+    {}
+
+    template<class F>
+    constexpr reveal_adaptor<F> operator=(const F& f) const
+    {
+        return reveal_adaptor<F>(f);
+    }
+};
+#endif
+
+#if !FIT_HAS_DIRECT_STATIC_LAMBDA
 template<class F>
 struct static_function_wrapper
 {
@@ -189,6 +224,9 @@ struct rewrite_lambda<T, typename std::enable_if<
 
 #endif
 
+#endif
+
+#if !FIT_HAS_DIRECT_STATIC_LAMBDA_FUNCTION
 template<class T>
 struct reveal_static_lambda_function_wrapper_factor
 {
@@ -215,16 +253,26 @@ struct reveal_static_lambda_function_wrapper_factor
     }
 #endif
 };
+#endif
 
 }} // namespace fit
 
+#if FIT_HAS_DIRECT_STATIC_LAMBDA_FUNCTION
+#define FIT_STATIC_LAMBDA_FUNCTION(name) \
+inline constexpr auto name = fit::detail::reveal_static_lambda_factory()
+#else
 #define FIT_DETAIL_MAKE_REVEAL_STATIC(T) FIT_DETAIL_CONSTEXPR_DEDUCE_UNIQUE(T) fit::detail::reveal_static_lambda_function_wrapper_factor<T>()
 #define FIT_STATIC_LAMBDA_FUNCTION(name) \
 struct fit_private_static_function_ ## name {}; \
 FIT_STATIC_AUTO_REF name = FIT_DETAIL_MAKE_REVEAL_STATIC(fit_private_static_function_ ## name)
+#endif
 
+#if FIT_HAS_DIRECT_STATIC_LAMBDA
+#define FIT_STATIC_LAMBDA []
+#else
 #define FIT_DETAIL_MAKE_STATIC FIT_DETAIL_CONSTEXPR_DEDUCE fit::detail::static_function_wrapper_factor()
 #define FIT_STATIC_LAMBDA FIT_DETAIL_MAKE_STATIC = []
+#endif
 
 
 #endif
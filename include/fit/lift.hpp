@@ -22,6 +22,13 @@
 /// This will preserve `constexpr` and it can be used on older compilers that
 /// don't support generic lambdas yet.
 /// 
+/// Each `FIT_LIFT` creates a new closure type, so the same function lifted in
+/// two places will instantiate everything that uses it twice. The
+/// `FIT_LIFT_NAMED` macro declares a function object named `name` at
+/// namespace scope instead. Every use of `name` has the same type, even across
+/// translation units when it is declared in a header, so the instantiations
+/// are shared.
+/// 
 /// Synopsis
 /// --------
 /// 
@@ -31,6 +38,9 @@
 ///     // Declare a class named `name` that will forward to the function
 ///     #define FIT_LIFT_CLASS(name, ...)
 /// 
+///     // Declare a function object named `name` that will forward to the function
+///     #define FIT_LIFT_NAMED(name, ...)
+/// 
 /// Example
 /// -------
 /// 
@@ -41,16 +51,21 @@
 ///     // Declare the class `max_f`
 ///     FIT_LIFT_CLASS(max_f, std::max);
 /// 
+///     // Declare the function object `lifted_max`
+///     FIT_LIFT_NAMED(lifted_max, std::max);
+/// 
 ///     int main() {
 ///         auto my_max = FIT_LIFT(std::max);
 ///         assert(my_max(3, 4) == std::max(3, 4));
 ///         assert(max_f()(3, 4) == std::max(3, 4));
+///         assert(lifted_max(3, 4) == std::max(3, 4));
 ///     }
 /// 
 
 #include <fit/returns.hpp>
 #include <fit/lambda.hpp>
 #include <fit/detail/forward.hpp>
+#include <fit/detail/static_const_var.hpp>
 
 #ifdef _MSC_VER
 #define FIT_LIFT(...) (FIT_STATIC_LAMBDA { FIT_LIFT_CLASS(fit_local_lift_t, __VA_ARGS__); return fit_local_lift_t(); }())
@@ -66,4 +81,8 @@ struct name \
     FIT_RETURNS((__VA_ARGS__)(FIT_FORWARD(Ts)(xs)...)) \
 }
 
+#define FIT_LIFT_NAMED(name, ...) \
+FIT_LIFT_CLASS(fit_lifted_ ## name, __VA_ARGS__); \
+FIT_DECLARE_STATIC_VAR(name, fit_lifted_ ## name)
+
 #endif
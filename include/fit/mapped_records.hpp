@@ -0,0 +1,558 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    mapped_records.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_MAPPED_RECORDS_H
+#define FIT_GUARD_MAPPED_RECORDS_H
+
+/// mapped_records
+/// ==============
+///
+/// Description
+/// -----------
+///
+/// The `mapped_records` function maps a file of fixed-size records into
+/// memory as read-only, so the records can be read without parsing or
+/// copying. The layout of a record is given by the field types `Ts...`, which
+/// are stored one after another with no padding between them. A
+/// `mapped_padding<N>` field can be used to skip `N` unused bytes.
+///
+/// Each record is a `mapped_record<Ts...>`, which can be
+/// [unpacked](/include/fit/unpack) to `const` references to its fields, other
+/// than the padding, that refer directly to the mapped file. So functions
+/// like [`unpack`](/include/fit/unpack), [`by`](/include/fit/by), and
+/// [`compress`](/include/fit/compress) can run over the file directly.
+///
+/// Each field must start at an offset that is a multiple of its alignment,
+/// and the size of the record must be a multiple of the largest alignment,
+/// so every field of every record is aligned. This is checked when the
+/// layout is compiled. The fields must be trivially copyable, and are read
+/// with the layout and endianness of the platform.
+///
+/// The returned `record_mapping` owns the mapping, and can only be moved.
+/// When the file can't be opened or mapped, or its size isn't a multiple of
+/// the size of a record, the mapping is empty and `ok()` returns false. On
+/// platforms without `mmap`, the file is read into memory instead. Since it
+/// needs the system headers for `mmap`, this header isn't included by
+/// `fit.hpp`, and has to be included on its own.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Ts>
+///     record_mapping<Ts...> mapped_records(const char * path);
+///
+///     template<class... Ts>
+///     record_mapping<Ts...> mapped_records(const std::string& path);
+///
+/// Requirements
+/// ------------
+///
+/// Ts must be:
+///
+/// * TriviallyCopyable
+///
+/// Example
+/// -------
+///
+///     #include <fit/mapped_records.hpp>
+///     #include <fit/compress.hpp>
+///     #include <fit/unpack.hpp>
+///     #include <cassert>
+///     #include <cstdint>
+///     #include <cstdio>
+///
+///     struct add
+///     {
+///         template<class T, class U>
+///         double operator()(T x, U y) const
+///         {
+///             return x + y;
+///         }
+///     };
+///
+///     int main() {
+///         std::FILE * f = std::fopen("example.bin", "wb");
+///         for(std::int32_t i=0;i<4;i++)
+///         {
+///             float x = i * 0.5f;
+///             std::fwrite(&i, sizeof(i), 1, f);
+///             std::fwrite(&x, sizeof(x), 1, f);
+///         }
+///         std::fclose(f);
+///
+///         auto records = fit::mapped_records<std::int32_t, float>("example.bin");
+///         assert(records.ok());
+///         assert(records.size() == 4);
+///         assert(fit::unpack(fit::compress(add(), 0.0))(records[3]) == 4.5);
+///         std::remove("example.bin");
+///     }
+///
+
+#include <fit/returns.hpp>
+#include <fit/unpack_sequence.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/intrinsics.hpp>
+#include <fit/detail/seq.hpp>
+#include <cstddef>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+
+#ifndef FIT_MAPPED_RECORDS_MMAP
+#if defined(__unix__) || defined(__APPLE__)
+#define FIT_MAPPED_RECORDS_MMAP 1
+#else
+#define FIT_MAPPED_RECORDS_MMAP 0
+#endif
+#endif
+
+#if FIT_MAPPED_RECORDS_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fit {
+
+template<std::size_t N>
+struct mapped_padding
+{
+    unsigned char bytes[N];
+};
+
+namespace detail {
+
+template<class T>
+struct mapped_is_padding
+: std::false_type
+{};
+
+template<std::size_t N>
+struct mapped_is_padding<mapped_padding<N>>
+: std::true_type
+{};
+
+template<std::size_t I, class... Ts>
+struct mapped_offset
+: std::integral_constant<std::size_t, 0>
+{};
+
+template<std::size_t I, class T, class... Ts>
+struct mapped_offset<I, T, Ts...>
+: std::integral_constant<std::size_t, sizeof(T) + mapped_offset<I - 1, Ts...>::value>
+{};
+
+template<class T, class... Ts>
+struct mapped_offset<0, T, Ts...>
+: std::integral_constant<std::size_t, 0>
+{};
+
+template<std::size_t Offset, class... Ts>
+struct mapped_is_aligned
+: std::true_type
+{};
+
+template<std::size_t Offset, class T, class... Ts>
+struct mapped_is_aligned<Offset, T, Ts...>
+: std::integral_constant<bool, (Offset % alignof(T) == 0 && mapped_is_aligned<Offset + sizeof(T), Ts...>::value)>
+{};
+
+template<class... Ts>
+struct mapped_alignment
+: std::integral_constant<std::size_t, 1>
+{};
+
+template<class T, class... Ts>
+struct mapped_alignment<T, Ts...>
+: std::integral_constant<std::size_t, (alignof(T) > mapped_alignment<Ts...>::value ? alignof(T) : mapped_alignment<Ts...>::value)>
+{};
+
+template<class... Ts>
+struct mapped_is_trivial
+: std::true_type
+{};
+
+template<class T, class... Ts>
+struct mapped_is_trivial<T, Ts...>
+: std::integral_constant<bool, (FIT_IS_TRIVIALLY_COPYABLE(T) && mapped_is_trivial<Ts...>::value)>
+{};
+
+// The indices of the fields that are not padding
+template<class Seq, std::size_t I, class... Ts>
+struct mapped_fields
+: Seq
+{};
+
+template<std::size_t... Ns, std::size_t I, class T, class... Ts>
+struct mapped_fields<seq<Ns...>, I, T, Ts...>
+: std::conditional<mapped_is_padding<T>::value,
+    mapped_fields<seq<Ns...>, I + 1, Ts...>,
+    mapped_fields<seq<Ns..., I>, I + 1, Ts...>
+>::type
+{};
+
+template<class... Ts>
+struct mapped_layout
+{
+    static const std::size_t size = mapped_offset<sizeof...(Ts), Ts...>::value;
+    static const std::size_t alignment = mapped_alignment<Ts...>::value;
+
+    static_assert(sizeof...(Ts) > 0, "A record needs at least one field");
+    static_assert(mapped_is_trivial<Ts...>::value, "The fields of a mapped record must be trivially copyable");
+    static_assert(mapped_is_aligned<0, Ts...>::value,
+        "Each field of a mapped record must start at a multiple of its alignment; reorder the fields or add mapped_padding");
+    static_assert(size % alignment == 0,
+        "The size of a mapped record must be a multiple of the alignment of its fields; add mapped_padding at the end");
+};
+
+}
+
+template<class... Ts>
+class mapped_record
+{
+    const unsigned char * p;
+public:
+    typedef detail::mapped_layout<Ts...> layout;
+
+    explicit mapped_record(const unsigned char * data) : p(data)
+    {}
+
+    template<std::size_t I>
+    const typename std::tuple_element<I, std::tuple<Ts...>>::type& get() const
+    {
+        typedef typename std::tuple_element<I, std::tuple<Ts...>>::type field;
+        return *reinterpret_cast<const field*>(p + detail::mapped_offset<I, Ts...>::value);
+    }
+
+    const unsigned char * data() const
+    {
+        return p;
+    }
+};
+
+namespace detail {
+
+template<class F, class... Ts, std::size_t... Ns>
+constexpr auto unpack_mapped(F&& f, const mapped_record<Ts...>& r, seq<Ns...>) FIT_RETURNS
+(
+    f(r.template get<Ns>()...)
+);
+
+}
+
+template<class... Ts>
+struct unpack_sequence<mapped_record<Ts...>>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        detail::unpack_mapped(FIT_FORWARD(F)(f), s, typename detail::mapped_fields<detail::seq<>, 0, Ts...>::type())
+    );
+};
+
+template<class... Ts>
+class record_mapping
+{
+    typedef detail::mapped_layout<Ts...> layout;
+    static_assert(layout::alignment <= alignof(std::max_align_t), "Over-aligned fields are not supported");
+
+    const unsigned char * first;
+    std::size_t count;
+    std::size_t length;
+    bool mapped;
+    bool opened;
+
+    void release()
+    {
+#if FIT_MAPPED_RECORDS_MMAP
+        if (mapped) ::munmap(const_cast<unsigned char*>(first), length);
+#endif
+        if (!mapped && first != nullptr) delete[] reinterpret_cast<const std::max_align_t*>(first);
+        first = nullptr;
+        count = 0;
+        length = 0;
+        mapped = false;
+    }
+
+    void take(record_mapping& rhs)
+    {
+        first = rhs.first;
+        count = rhs.count;
+        length = rhs.length;
+        mapped = rhs.mapped;
+        opened = rhs.opened;
+        rhs.first = nullptr;
+        rhs.count = 0;
+        rhs.length = 0;
+        rhs.mapped = false;
+        rhs.opened = false;
+    }
+
+#if FIT_MAPPED_RECORDS_MMAP
+    void open(const char * path)
+    {
+        int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && std::size_t(st.st_size) % layout::size == 0)
+        {
+            length = st.st_size;
+            if (length == 0) opened = true;
+            else
+            {
+                void * p = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (p != MAP_FAILED)
+                {
+                    first = static_cast<const unsigned char*>(p);
+                    count = length / layout::size;
+                    mapped = true;
+                    opened = true;
+                }
+                else length = 0;
+            }
+        }
+        ::close(fd);
+    }
+#else
+    void open(const char * path)
+    {
+        std::FILE * f = std::fopen(path, "rb");
+        if (f == nullptr) return;
+        if (std::fseek(f, 0, SEEK_END) == 0)
+        {
+            long n = std::ftell(f);
+            if (n >= 0 && std::size_t(n) % layout::size == 0 && std::fseek(f, 0, SEEK_SET) == 0)
+            {
+                std::size_t words = (std::size_t(n) + sizeof(std::max_align_t) - 1) / sizeof(std::max_align_t);
+                unsigned char * p = reinterpret_cast<unsigned char*>(new std::max_align_t[words]);
+                if (std::fread(p, 1, n, f) == std::size_t(n))
+                {
+                    first = p;
+                    count = n / layout::size;
+                    length = n;
+                    opened = true;
+                }
+                else delete[] reinterpret_cast<std::max_align_t*>(p);
+            }
+        }
+        std::fclose(f);
+    }
+#endif
+
+public:
+    typedef mapped_record<Ts...> value_type;
+
+    class iterator
+    {
+        const unsigned char * p;
+    public:
+        // Records are made when the iterator is dereferenced, so the arrow
+        // holds the record it points to
+        struct arrow
+        {
+            mapped_record<Ts...> record;
+
+            const mapped_record<Ts...> * operator->() const
+            {
+                return &record;
+            }
+        };
+
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef mapped_record<Ts...> value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef arrow pointer;
+        typedef mapped_record<Ts...> reference;
+
+        iterator() : p(nullptr)
+        {}
+
+        explicit iterator(const unsigned char * data) : p(data)
+        {}
+
+        reference operator*() const
+        {
+            return reference(p);
+        }
+
+        pointer operator->() const
+        {
+            return pointer{ reference(p) };
+        }
+
+        reference operator[](difference_type n) const
+        {
+            return reference(p + n*difference_type(layout::size));
+        }
+
+        iterator& operator++()
+        {
+            p += layout::size;
+            return *this;
+        }
+
+        iterator operator++(int)
+        {
+            iterator it = *this;
+            ++*this;
+            return it;
+        }
+
+        iterator& operator--()
+        {
+            p -= layout::size;
+            return *this;
+        }
+
+        iterator operator--(int)
+        {
+            iterator it = *this;
+            --*this;
+            return it;
+        }
+
+        iterator& operator+=(difference_type n)
+        {
+            p += n*difference_type(layout::size);
+            return *this;
+        }
+
+        iterator& operator-=(difference_type n)
+        {
+            p -= n*difference_type(layout::size);
+            return *this;
+        }
+
+        friend iterator operator+(iterator it, difference_type n)
+        {
+            return it += n;
+        }
+
+        friend iterator operator+(difference_type n, iterator it)
+        {
+            return it += n;
+        }
+
+        friend iterator operator-(iterator it, difference_type n)
+        {
+            return it -= n;
+        }
+
+        friend difference_type operator-(iterator x, iterator y)
+        {
+            return (x.p - y.p) / difference_type(layout::size);
+        }
+
+        friend bool operator==(iterator x, iterator y)
+        {
+            return x.p == y.p;
+        }
+
+        friend bool operator!=(iterator x, iterator y)
+        {
+            return x.p != y.p;
+        }
+
+        friend bool operator<(iterator x, iterator y)
+        {
+            return x.p < y.p;
+        }
+
+        friend bool operator>(iterator x, iterator y)
+        {
+            return x.p > y.p;
+        }
+
+        friend bool operator<=(iterator x, iterator y)
+        {
+            return x.p <= y.p;
+        }
+
+        friend bool operator>=(iterator x, iterator y)
+        {
+            return x.p >= y.p;
+        }
+    };
+
+    explicit record_mapping(const char * path)
+    : first(nullptr), count(0), length(0), mapped(false), opened(false)
+    {
+        this->open(path);
+    }
+
+    record_mapping(record_mapping&& rhs) noexcept
+    {
+        this->take(rhs);
+    }
+
+    record_mapping& operator=(record_mapping&& rhs) noexcept
+    {
+        if (this != &rhs)
+        {
+            this->release();
+            this->take(rhs);
+        }
+        return *this;
+    }
+
+    record_mapping(const record_mapping&) = delete;
+    record_mapping& operator=(const record_mapping&) = delete;
+
+    ~record_mapping()
+    {
+        this->release();
+    }
+
+    bool ok() const
+    {
+        return opened;
+    }
+
+    std::size_t size() const
+    {
+        return count;
+    }
+
+    bool empty() const
+    {
+        return count == 0;
+    }
+
+    mapped_record<Ts...> operator[](std::size_t i) const
+    {
+        return mapped_record<Ts...>(first + i*layout::size);
+    }
+
+    iterator begin() const
+    {
+        return iterator(first);
+    }
+
+    iterator end() const
+    {
+        return iterator(first + count*layout::size);
+    }
+};
+
+template<class... Ts>
+record_mapping<Ts...> mapped_records(const char * path)
+{
+    return record_mapping<Ts...>(path);
+}
+
+template<class... Ts>
+record_mapping<Ts...> mapped_records(const std::string& path)
+{
+    return record_mapping<Ts...>(path.c_str());
+}
+
+} // namespace fit
+
+#endif
@@ -0,0 +1,139 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    member.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_MEMBER_H
+#define FIT_GUARD_MEMBER_H
+
+/// member
+/// ======
+///
+/// Description
+/// -----------
+///
+/// The `member` and `method` function objects call a member pointer that is
+/// given as a template parameter, instead of being stored. A member pointer
+/// passed to an adaptor such as [`by`](/include/fit/by) is stored in the
+/// adaptor, so the adaptor is no longer empty and each call may load the
+/// offset from memory. Since `member` and `method` are empty, the adaptors
+/// stay empty and the offset is a constant.
+///
+/// `member` is used for member data and `method` is used for member
+/// functions, which can take extra arguments. The object can be passed as a
+/// reference, a pointer or a `std::reference_wrapper`, just like with
+/// [`apply`](/include/fit/apply).
+///
+/// Writing `member<&T::x>` needs `auto` template parameters, which is
+/// available in C++17. Otherwise, the `FIT_MEMBER` and `FIT_METHOD` macros
+/// can be used to create them, or the `member_projection` and
+/// `method_projection` classes can be used directly.
+///
+/// Synopsis
+/// --------
+///
+///     template<class M, M Pointer>
+///     struct member_projection;
+///
+///     template<class M, M Pointer>
+///     struct method_projection;
+///
+///     template<auto Pointer>
+///     constexpr member_projection<decltype(Pointer), Pointer> member = {};
+///
+///     template<auto Pointer>
+///     constexpr method_projection<decltype(Pointer), Pointer> method = {};
+///
+///     #define FIT_MEMBER(pointer)
+///     #define FIT_METHOD(pointer)
+///
+/// Semantics
+/// ---------
+///
+///     assert(member<&T::x>(t) == t.x);
+///     assert(method<&T::f>(t, xs...) == t.f(xs...));
+///     assert(FIT_MEMBER(&T::x)(t) == t.x);
+///
+/// Requirements
+/// ------------
+///
+/// For `member`, Pointer must be:
+///
+/// * A pointer to member data
+///
+/// For `method`, Pointer must be:
+///
+/// * A pointer to member function
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <functional>
+///
+///     struct person
+///     {
+///         int age;
+///     };
+///
+///     int main() {
+///         auto older = fit::by(FIT_MEMBER(&person::age), std::greater<int>());
+///         person a = {40};
+///         person b = {30};
+///         assert(older(a, b));
+///     }
+///
+
+#include <fit/apply.hpp>
+#include <fit/config.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/result_of.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <type_traits>
+
+namespace fit {
+
+namespace detail {
+
+template<class M, M Pointer>
+struct member_pointer_base
+{
+    template<class... Ts>
+    constexpr FIT_SFINAE_RESULT(apply_f, id_<M>, id_<Ts>...)
+    operator()(Ts&&... xs) const FIT_SFINAE_RETURNS
+    (
+        fit::apply(Pointer, FIT_FORWARD(Ts)(xs)...)
+    );
+};
+
+}
+
+template<class M, M Pointer>
+struct member_projection : detail::member_pointer_base<M, Pointer>
+{
+    static_assert(std::is_member_object_pointer<M>::value, "member requires a pointer to member data");
+};
+
+template<class M, M Pointer>
+struct method_projection : detail::member_pointer_base<M, Pointer>
+{
+    static_assert(std::is_member_function_pointer<M>::value, "method requires a pointer to member function");
+};
+
+#if FIT_HAS_TEMPLATE_AUTO && FIT_HAS_VARIABLE_TEMPLATES
+template<auto Pointer>
+FIT_STATIC_CONSTEXPR member_projection<decltype(Pointer), Pointer> member = {};
+
+template<auto Pointer>
+FIT_STATIC_CONSTEXPR method_projection<decltype(Pointer), Pointer> method = {};
+#endif
+
+} // namespace fit
+
+#define FIT_MEMBER(...) fit::member_projection<decltype(__VA_ARGS__), __VA_ARGS__>()
+#define FIT_METHOD(...) fit::method_projection<decltype(__VA_ARGS__), __VA_ARGS__>()
+
+#endif
@@ -0,0 +1,278 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    once.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_ONCE_H
+#define FIT_GUARD_ONCE_H
+
+/// once
+/// ====
+///
+/// Description
+/// -----------
+///
+/// The `once` function adaptor takes a nullary function, and calls it at most
+/// once. The first call computes the result, and every call returns a
+/// reference to the cached result. Copies of the adaptor share the same
+/// result, so the function is still only called once.
+///
+/// When several threads call it for the first time, only one of them calls
+/// the function and the others wait for it to finish. After that, a call is
+/// only an atomic load. If the function throws, the result is not cached, and
+/// the next call will try again. If `FIT_SINGLE_THREADED` is enabled, no
+/// synchronization is used.
+///
+/// The `lazy_value` function works the same, except it takes a thunk that is
+/// evaluated with [`eval`](/include/fit/eval). Both can be used as a thunk
+/// for `eval` and `apply_eval`.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F>
+///     once_adaptor<F> once(F f);
+///
+///     template<class F>
+///     auto lazy_value(F f);
+///
+/// Semantics
+/// ---------
+///
+///     assert(once(f)() == f());
+///     auto g = once(f);
+///     assert(&g() == &g());
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// For `lazy_value`, F must be:
+///
+/// * [EvaluatableFunctionObject](EvaluatableFunctionObject)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <vector>
+///
+///     struct make_table
+///     {
+///         std::vector<int> operator()() const
+///         {
+///             return std::vector<int>(1024, 1);
+///         }
+///     };
+///
+///     int main() {
+///         auto table = fit::once(make_table());
+///         assert(table().size() == 1024);
+///         assert(&table() == &table());
+///     }
+///
+
+#include <fit/config.hpp>
+#include <fit/eval.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <memory>
+#include <new>
+#include <type_traits>
+#if !FIT_SINGLE_THREADED
+#include <atomic>
+#include <mutex>
+#endif
+
+namespace fit {
+
+namespace detail {
+
+template<class R>
+struct once_storage
+{
+    typedef typename std::remove_cv<R>::type value_type;
+    typedef const value_type& result_type;
+    alignas(value_type) unsigned char buffer[sizeof(value_type)];
+
+    template<class F>
+    void init(const F& f)
+    {
+        new (buffer) value_type(f());
+    }
+
+    result_type get() const
+    {
+        return *reinterpret_cast<const value_type*>(buffer);
+    }
+
+    void destroy()
+    {
+        reinterpret_cast<value_type*>(buffer)->~value_type();
+    }
+};
+
+template<class R>
+struct once_storage<R&>
+{
+    typedef R& result_type;
+    R * pointer;
+
+    template<class F>
+    void init(const F& f)
+    {
+        pointer = &f();
+    }
+
+    result_type get() const
+    {
+        return *pointer;
+    }
+
+    void destroy()
+    {}
+};
+
+// The referred object may be a temporary, so the value is moved into the
+// storage instead
+template<class R>
+struct once_storage<R&&>
+: once_storage<R>
+{};
+
+template<>
+struct once_storage<void>
+{
+    typedef void result_type;
+
+    template<class F>
+    void init(const F& f)
+    {
+        f();
+    }
+
+    void get() const
+    {}
+
+    void destroy()
+    {}
+};
+
+template<class F>
+struct once_state : once_storage<decltype(std::declval<const F&>()())>
+{
+    typedef once_storage<decltype(std::declval<const F&>()())> base;
+    F f;
+#if FIT_SINGLE_THREADED
+    bool ready;
+#else
+    std::atomic<bool> ready;
+    std::mutex m;
+#endif
+
+    template<class X>
+    once_state(X&& x) : f(FIT_FORWARD(X)(x)), ready(false)
+    {}
+
+    once_state(const once_state&) = delete;
+    once_state& operator=(const once_state&) = delete;
+
+    ~once_state()
+    {
+        if (ready) this->destroy();
+    }
+
+    typename base::result_type call()
+    {
+#if FIT_SINGLE_THREADED
+        if (!ready)
+        {
+            this->init(f);
+            ready = true;
+        }
+#else
+        if (!ready.load(std::memory_order_acquire))
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if (!ready.load(std::memory_order_relaxed))
+            {
+                this->init(f);
+                ready.store(true, std::memory_order_release);
+            }
+        }
+#endif
+        return this->get();
+    }
+};
+
+}
+
+template<class F>
+struct once_adaptor
+{
+    typedef detail::once_state<F> state_type;
+    std::shared_ptr<state_type> state;
+
+    template<class X, class=typename std::enable_if<(
+        std::is_constructible<F, X&&>::value
+    )>::type>
+    explicit once_adaptor(X&& x) : state(std::make_shared<state_type>(FIT_FORWARD(X)(x)))
+    {}
+
+    typename state_type::result_type operator()() const
+    {
+        return state->call();
+    }
+};
+
+namespace detail {
+
+struct once_f
+{
+    template<class F>
+    once_adaptor<F> operator()(F f) const
+    {
+        return once_adaptor<F>(static_cast<F&&>(f));
+    }
+};
+
+template<class F>
+struct lazy_value_thunk
+{
+    F f;
+
+    template<class X>
+    lazy_value_thunk(X&& x) : f(FIT_FORWARD(X)(x))
+    {}
+
+    decltype(fit::eval(std::declval<const F&>())) operator()() const
+    {
+        return fit::eval(f);
+    }
+};
+
+struct lazy_value_f
+{
+    template<class F>
+    once_adaptor<lazy_value_thunk<F>> operator()(F f) const
+    {
+        return once_adaptor<lazy_value_thunk<F>>(static_cast<F&&>(f));
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(once, detail::once_f);
+FIT_DECLARE_STATIC_VAR(lazy_value, detail::lazy_value_f);
+
+} // namespace fit
+
+#endif
@@ -19,6 +19,10 @@
 /// a sequence that can be unpacked with `unpack_adaptor` as well. Also,
 /// `pack_join` can be used to join multiple packs together.
 /// 
+/// When none of the elements are references, they are stored from the
+/// largest alignment to the smallest, so no space is lost to padding between
+/// them. They are still passed to the function in the order they were given.
+/// 
 /// Synopsis
 /// --------
 /// 
@@ -71,6 +75,7 @@
 
 #include <fit/detail/seq.hpp>
 #include <fit/detail/delegate.hpp>
+#include <fit/detail/pack_indirect.hpp>
 #include <fit/detail/remove_rvalue_reference.hpp>
 #include <fit/detail/unwrap.hpp>
 #include <fit/detail/static_const_var.hpp>
@@ -106,7 +111,7 @@ struct is_copyable
 {};
 
 template<class T, class Tag, class X, class... Ts, typename std::enable_if<
-    is_copyable<T>::value && !std::is_lvalue_reference<T>::value
+    is_copyable<T>::value && !std::is_lvalue_reference<T>::value && !pack_indirect<typename std::decay<T>::type>::value
 , int>::type = 0>
 constexpr T pack_get(X&& x, Ts&&... xs)
 {
@@ -114,7 +119,15 @@ constexpr T pack_get(X&& x, Ts&&... xs)
 }
 
 template<class T, class Tag, class X, class... Ts, typename std::enable_if<
-    std::is_lvalue_reference<T>::value
+    pack_indirect<typename std::decay<T>::type>::value
+, int>::type = 0>
+constexpr typename pack_indirect<typename std::decay<T>::type>::type pack_get(X&& x, Ts&&... xs)
+{
+    return pack_indirect<typename std::decay<T>::type>::get(fit::alias_value<Tag, T>(x, xs...));
+}
+
+template<class T, class Tag, class X, class... Ts, typename std::enable_if<
+    std::is_lvalue_reference<T>::value && !pack_indirect<typename std::decay<T>::type>::value
 , int>::type = 0>
 constexpr T pack_get(X&& x, Ts&&... xs)
 {
@@ -129,6 +142,39 @@ constexpr auto pack_get(X&& x, Ts&&... xs) FIT_RETURNS
     fit::alias_value<Tag, T>(FIT_FORWARD(X)(x), xs...)
 );
 
+template<class T, typename std::enable_if<
+    !pack_indirect<typename std::decay<T>::type>::value
+, int>::type = 0>
+constexpr T&& pack_unwrap(T&& x)
+{
+    return FIT_FORWARD(T)(x);
+}
+
+template<class T, typename std::enable_if<
+    pack_indirect<typename std::decay<T>::type>::value
+, int>::type = 0>
+constexpr typename pack_indirect<typename std::decay<T>::type>::type pack_unwrap(T&& x)
+{
+    return pack_indirect<typename std::decay<T>::type>::get(x);
+}
+
+// When joining packs, an indirect element is copied instead of its value
+template<class T, class Tag, class X, class... Ts, typename std::enable_if<
+    pack_indirect<typename std::decay<T>::type>::value
+, int>::type = 0>
+constexpr T pack_join_get(X&& x, Ts&&... xs)
+{
+    return static_cast<T>(fit::alias_value<Tag, T>(FIT_FORWARD(X)(x), xs...));
+}
+
+template<class T, class Tag, class X, class... Ts, typename std::enable_if<
+    !pack_indirect<typename std::decay<T>::type>::value
+, int>::type = 0>
+constexpr auto pack_join_get(X&& x, Ts&&... xs) FIT_RETURNS
+(
+    detail::pack_get<T, Tag>(FIT_FORWARD(X)(x), xs...)
+);
+
 #if (defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7) || defined(_MSC_VER)
 template<class... Ts>
 struct pack_holder_base
@@ -226,15 +272,120 @@ struct pack_base<seq<0>, T>
 
 #else
 
+// An element of the pack, with its index in the pack and its holder
+template<std::size_t N, class Holder>
+struct pack_slot
+{
+    static const std::size_t index = N;
+    static const std::size_t alignment = alignof(Holder);
+    typedef Holder holder;
+};
+
+template<class... Slots>
+struct pack_slots
+{
+    typedef pack_slots type;
+};
+
+template<class Slot, class Slots>
+struct pack_slots_prepend;
+
+template<class Slot, class... Slots>
+struct pack_slots_prepend<Slot, pack_slots<Slots...>>
+: pack_slots<Slot, Slots...>
+{};
+
+// Inserts the slot after every slot with the same or a larger alignment, so
+// the sort is stable
+template<class Slot, class Slots>
+struct pack_slots_insert
+: pack_slots<Slot>
+{};
+
+template<class Slot, class S, class... Ss>
+struct pack_slots_insert<Slot, pack_slots<S, Ss...>>
+: std::conditional<(Slot::alignment > S::alignment),
+    pack_slots<Slot, S, Ss...>,
+    pack_slots_prepend<S, typename pack_slots_insert<Slot, pack_slots<Ss...>>::type>
+>::type
+{};
+
+template<class Sorted, class... Slots>
+struct pack_slots_sort
+: Sorted
+{};
+
+template<class Sorted, class Slot, class... Slots>
+struct pack_slots_sort<Sorted, Slot, Slots...>
+: pack_slots_sort<typename pack_slots_insert<Slot, Sorted>::type, Slots...>
+{};
+
+// Elements are stored from the largest alignment to the smallest, which
+// leaves no padding between them. Packs of references are stored in order.
+template<class Seq, class... Ts>
+struct pack_layout;
+
+template<std::size_t... Ns, class... Ts>
+struct pack_layout<seq<Ns...>, Ts...>
+: std::conditional<FIT_AND_UNPACK(!std::is_reference<Ts>::value),
+    pack_slots_sort<pack_slots<>, pack_slot<Ns, typename pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type>...>,
+    pack_slots<pack_slot<Ns, typename pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type>...>
+>::type
+{};
+
+template<std::size_t N, class... Xs>
+struct pack_arg_type;
+
+template<class X, class... Xs>
+struct pack_arg_type<0, X, Xs...>
+{
+    typedef X&& type;
+};
+
+template<std::size_t N, class X, class... Xs>
+struct pack_arg_type<N, X, Xs...>
+: pack_arg_type<N - 1, Xs...>
+{};
+
+template<std::size_t N, class X, class... Xs, typename std::enable_if<(N == 0), int>::type = 0>
+constexpr X&& pack_arg(X&& x, Xs&&...)
+{
+    return FIT_FORWARD(X)(x);
+}
+
+template<std::size_t N, class X, class... Xs, typename std::enable_if<(N > 0), int>::type = 0>
+constexpr typename pack_arg_type<N - 1, Xs...>::type pack_arg(X&&, Xs&&... xs)
+{
+    return detail::pack_arg<N - 1>(FIT_FORWARD(Xs)(xs)...);
+}
+
+template<class Slots, class... Ts>
+struct pack_storage;
+
+template<class... Slots, class... Ts>
+struct pack_storage<pack_slots<Slots...>, Ts...>
+: Slots::holder...
+{
+    FIT_INHERIT_DEFAULT(pack_storage, Ts...);
+
+    // The arguments are in the order of the pack, so each holder picks its
+    // own argument by index
+    template<class X, class... Xs>
+    constexpr pack_storage(X&& x, Xs&&... xs)
+    : Slots::holder(detail::pack_arg<Slots::index>(FIT_FORWARD(X)(x), FIT_FORWARD(Xs)(xs)...))...
+    {}
+};
+
 template<std::size_t... Ns, class... Ts>
 struct pack_base<seq<Ns...>, Ts...>
-: pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type...
+: pack_storage<typename pack_layout<seq<Ns...>, Ts...>::type, Ts...>
 {
+    typedef pack_storage<typename pack_layout<seq<Ns...>, Ts...>::type, Ts...> base;
     // FIT_INHERIT_DEFAULT(pack_base, typename std::remove_cv<typename std::remove_reference<Ts>::type>::type...);
     FIT_INHERIT_DEFAULT(pack_base, Ts...);
     
     template<class... Xs, FIT_ENABLE_IF_CONVERTIBLE_UNPACK(Xs&&, typename pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type)>
-    constexpr pack_base(Xs&&... xs) : pack_holder<Ts, pack_tag<seq<Ns>, Ts...>>::type(FIT_FORWARD(Xs)(xs))...
+    constexpr pack_base(Xs&&... xs) : base(FIT_FORWARD(Xs)(xs)...)
     {}
   
     template<class F>
@@ -271,7 +422,7 @@ struct pack_base<seq<> >
 #define FIT_DETAIL_UNPACK_PACK_BASE(ref, move) \
 template<class F, std::size_t... Ns, class... Ts> \
 constexpr auto unpack_pack_base(F&& f, pack_base<seq<Ns...>, Ts...> ref x) \
-FIT_RETURNS(f(fit::alias_value<pack_tag<seq<Ns>, Ts...>, Ts>(move(x), f)...))
+FIT_RETURNS(f(detail::pack_unwrap(fit::alias_value<pack_tag<seq<Ns>, Ts...>, Ts>(move(x), f))...))
 FIT_UNARY_PERFECT_FOREACH(FIT_DETAIL_UNPACK_PACK_BASE)
 
 template<class P1, class P2>
@@ -288,8 +439,8 @@ struct pack_join_base<pack_base<seq<Ns1...>, Ts1...>, pack_base<seq<Ns2...>, Ts2
     static constexpr result_type call(P1&& p1, P2&& p2)
     {
         return result_type(
-            detail::pack_get<Ts1, pack_tag<seq<Ns1>, Ts1...>>(FIT_FORWARD(P1)(p1))..., 
-            detail::pack_get<Ts2, pack_tag<seq<Ns2>, Ts2...>>(FIT_FORWARD(P2)(p2))...);
+            detail::pack_join_get<Ts1, pack_tag<seq<Ns1>, Ts1...>>(FIT_FORWARD(P1)(p1))..., 
+            detail::pack_join_get<Ts2, pack_tag<seq<Ns2>, Ts2...>>(FIT_FORWARD(P2)(p2))...);
     }
 };
 
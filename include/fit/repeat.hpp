@@ -17,6 +17,13 @@
 /// The `repeat` function decorator will repeatedly apply a function a given
 /// number of times.
 /// 
+/// When the number is an `IntegralConstant`, the calls are unrolled. If the
+/// function returns the same type it is given, the calls are unrolled in
+/// blocks of 8, so large numbers don't reach the template depth limit.
+/// Then the blocks are called in a loop, or with relaxed `constexpr`
+/// unavailable, by splitting the count in half recursively. Either way, it
+/// still works in a `constexpr` context.
+/// 
 /// 
 /// Synopsis
 /// --------
@@ -64,6 +71,9 @@
 #include <fit/decorate.hpp>
 #include <fit/conditional.hpp>
 #include <fit/detail/recursive_constexpr_depth.hpp>
+#include <fit/detail/relaxed_constexpr.hpp>
+#include <fit/detail/holder.hpp>
+#include <type_traits>
 
 namespace fit { namespace detail {
 
@@ -88,6 +98,87 @@ struct repeater<0>
     }
 };
 
+static constexpr int repeat_block_size = 8;
+
+template<int N>
+struct repeat_unrolled
+{
+    template<class F, class T>
+    constexpr T operator()(const F& f, T x) const
+    {
+        return repeat_unrolled<N-1>()(f, f(fit::move(x)));
+    }
+};
+
+template<>
+struct repeat_unrolled<0>
+{
+    template<class F, class T>
+    constexpr T operator()(const F&, T x) const
+    {
+        return x;
+    }
+};
+
+#if FIT_HAS_RELAXED_CONSTEXPR
+template<int N>
+struct repeat_blocks
+{
+    template<class F, class T>
+    constexpr T operator()(const F& f, T x) const
+    {
+        for(int i=0;i<N/repeat_block_size;i++) x = repeat_unrolled<repeat_block_size>()(f, fit::move(x));
+        return repeat_unrolled<N % repeat_block_size>()(f, fit::move(x));
+    }
+};
+#else
+template<int N, class=void>
+struct repeat_blocks
+{
+    template<class F, class T>
+    constexpr T operator()(const F& f, T x) const
+    {
+        return repeat_blocks<N - N/2>()(f, repeat_blocks<N/2>()(f, fit::move(x)));
+    }
+};
+
+template<int N>
+struct repeat_blocks<N, typename std::enable_if<(N <= repeat_block_size)>::type>
+: repeat_unrolled<N>
+{};
+#endif
+
+// Whether calling the function on its result returns the same type, so the
+// result can be stored between the blocks
+template<class F, class R, class=void>
+struct repeat_is_stable
+: std::false_type
+{};
+
+template<class F, class R>
+struct repeat_is_stable<F, R, typename holder<
+    decltype(std::declval<const F&>()(std::declval<R>()))
+>::type>
+: std::integral_constant<bool, (
+    std::is_same<decltype(std::declval<const F&>()(std::declval<R>())), R>::value &&
+    !std::is_reference<R>::value &&
+    (!FIT_HAS_RELAXED_CONSTEXPR || std::is_move_assignable<R>::value)
+)>
+{};
+
+struct repeat_block_decorator
+{
+    template<class Integral, class F, class... Ts, 
+        class R=decltype(std::declval<const F&>()(std::declval<Ts>()...)), 
+        class=typename std::enable_if<(
+            (Integral::type::value > repeat_block_size) && repeat_is_stable<F, R>::value
+        )>::type>
+    constexpr R operator()(Integral, const F& f, Ts&&... xs) const
+    {
+        return detail::repeat_blocks<Integral::type::value - 1>()(f, f(FIT_FORWARD(Ts)(xs)...));
+    }
+};
+
 struct repeat_constant_decorator
 {
     template<class Integral, class F, class... Ts>
@@ -129,6 +220,7 @@ struct repeat_integral_decorator<0>
 
 FIT_DECLARE_STATIC_VAR(repeat, decorate_adaptor<
     fit::conditional_adaptor<
+    detail::repeat_block_decorator,
     detail::repeat_constant_decorator, 
     detail::repeat_integral_decorator<FIT_RECURSIVE_CONSTEXPR_DEPTH>
 >>);
@@ -0,0 +1,455 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    scan.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_SCAN_H
+#define FIT_GUARD_SCAN_H
+
+/// scan
+/// ====
+///
+/// Description
+/// -----------
+///
+/// The `scan` function adaptor folds the arguments like
+/// [`compress`](/include/fit/compress), but instead of returning only the
+/// final state, it returns a [`pack`](/include/fit/pack) of every state
+/// after each step, which is an inclusive prefix scan. The binary function
+/// is called once for each argument, from left to right.
+///
+/// The state always has the type of the initial state, so the binary
+/// function must return something convertible to it, and every element of
+/// the resulting pack has that type.
+///
+/// The `scan_range` function adaptor does the same over the elements of a
+/// range, and writes each state to an output iterator. It returns the
+/// output iterator past the last element written. When the function is
+/// `operators::add` or `std::plus`, the range is contiguous, the elements
+/// are arithmetic and of the same type as the state, and the output is a
+/// pointer to that type, then the prefix sums are computed several
+/// elements at a time with simd instructions. Since the additions are
+/// grouped differently, floating point results can differ from a loop in
+/// the last bits. The output can be the same as the input.
+///
+/// Synopsis
+/// --------
+///
+///     template<class F, class State>
+///     constexpr scan_adaptor<F, State> scan(F f, State s);
+///
+///     template<class F, class State>
+///     constexpr scan_range_adaptor<F, State> scan_range(F f, State s);
+///
+/// Semantics
+/// ---------
+///
+///     assert(scan(f, z)() == pack());
+///     assert(scan(f, z)(x, xs...) == pack_join(pack(f(z, x)), scan(f, f(z, x))(xs...)));
+///
+/// Requirements
+/// ------------
+///
+/// F must be:
+///
+/// * [BinaryCallable](BinaryCallable)
+/// * MoveConstructible
+///
+/// State must be:
+///
+/// * CopyConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <vector>
+///
+///     struct sum
+///     {
+///         template<class T, class U>
+///         constexpr T operator()(T x, U y) const
+///         {
+///             return x + y;
+///         }
+///     };
+///
+///     struct check_offsets
+///     {
+///         bool operator()(int a, int b, int c) const
+///         {
+///             return a == 4 && b == 12 && c == 14;
+///         }
+///     };
+///
+///     int main() {
+///         auto offsets = fit::scan(sum(), 0)(sizeof(int), sizeof(double), sizeof(short));
+///         assert(offsets(check_offsets()));
+///
+///         std::vector<float> v = { 1, 2, 3, 4, 5 };
+///         fit::scan_range(fit::operators::add(), 0.0f)(v, v.data());
+///         assert(v.back() == 15);
+///     }
+///
+
+#include <fit/conditional.hpp>
+#include <fit/pack.hpp>
+#include <fit/placeholders.hpp>
+#include <fit/detail/and.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/compressed_pair.hpp>
+#include <fit/detail/contiguous.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/indexed_refs.hpp>
+#include <fit/detail/make.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/detail/seq.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+
+#ifndef FIT_SCAN_SSE2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define FIT_SCAN_SSE2 1
+#else
+#define FIT_SCAN_SSE2 0
+#endif
+#endif
+
+#if FIT_SCAN_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace fit {
+
+namespace detail {
+
+template<class State, std::size_t N>
+struct scan_state
+{
+    typedef State type;
+};
+
+template<class State, class Seq>
+struct scan_result;
+
+template<class State, std::size_t... Ns>
+struct scan_result<State, seq<Ns...>>
+{
+    typedef pack_base<seq<Ns...>, typename scan_state<State, Ns>::type...> type;
+};
+
+template<std::size_t I, std::size_t N, class State>
+struct scan_push;
+
+// Each state is kept as an argument of the next step, so the pack is only
+// built once at the end
+template<std::size_t I, std::size_t N, class State>
+struct scan_fold
+{
+    typedef typename scan_result<State, typename gens<N>::type>::type result_type;
+
+    template<class F, class Refs, class... Rs>
+    constexpr result_type operator()(const F& f, const Refs& refs, State state, Rs&&... rs) const
+    {
+        return scan_push<I+1, N, State>()(
+            f, refs, static_cast<State>(f(fit::move(state), detail::indexed_get<I>(refs))), FIT_FORWARD(Rs)(rs)...
+        );
+    }
+};
+
+template<std::size_t N, class State>
+struct scan_fold<N, N, State>
+{
+    typedef typename scan_result<State, typename gens<N>::type>::type result_type;
+
+    template<class F, class Refs, class... Rs>
+    constexpr result_type operator()(const F&, const Refs&, const State&, Rs&&... rs) const
+    {
+        return result_type(FIT_FORWARD(Rs)(rs)...);
+    }
+};
+
+template<std::size_t I, std::size_t N, class State>
+struct scan_push
+{
+    template<class F, class Refs, class... Rs>
+    constexpr typename scan_fold<I, N, State>::result_type
+    operator()(const F& f, const Refs& refs, State state, Rs&&... rs) const
+    {
+        return scan_fold<I, N, State>()(f, refs, state, FIT_FORWARD(Rs)(rs)..., state);
+    }
+};
+
+template<class F, class State, class T, class=void>
+struct scan_step_is_callable
+: std::false_type
+{};
+
+template<class F, class State, class T>
+struct scan_step_is_callable<F, State, T, typename holder<
+    decltype(std::declval<F>()(std::declval<State>(), std::declval<T>()))
+>::type>
+: std::is_convertible<decltype(std::declval<F>()(std::declval<State>(), std::declval<T>())), State>
+{};
+
+template<class F>
+struct scan_is_add
+: std::false_type
+{};
+
+template<>
+struct scan_is_add<operators::add>
+: std::true_type
+{};
+
+template<class T>
+struct scan_is_add<std::plus<T>>
+: std::true_type
+{};
+
+#if FIT_SCAN_SSE2
+struct scan_sse2_float
+{
+    typedef float type;
+    typedef __m128 vec;
+    static const std::size_t lanes = 4;
+
+    static vec load(const float * p) { return _mm_loadu_ps(p); }
+    static void store(float * p, vec x) { _mm_storeu_ps(p, x); }
+    static vec add(vec x, vec y) { return _mm_add_ps(x, y); }
+    static vec set1(float x) { return _mm_set1_ps(x); }
+    static float first(vec x) { return _mm_cvtss_f32(x); }
+    static vec last(vec x) { return _mm_shuffle_ps(x, x, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static vec prefix(vec x)
+    {
+        x = _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 4)));
+        return _mm_add_ps(x, _mm_castsi128_ps(_mm_slli_si128(_mm_castps_si128(x), 8)));
+    }
+};
+
+struct scan_sse2_double
+{
+    typedef double type;
+    typedef __m128d vec;
+    static const std::size_t lanes = 2;
+
+    static vec load(const double * p) { return _mm_loadu_pd(p); }
+    static void store(double * p, vec x) { _mm_storeu_pd(p, x); }
+    static vec add(vec x, vec y) { return _mm_add_pd(x, y); }
+    static vec set1(double x) { return _mm_set1_pd(x); }
+    static double first(vec x) { return _mm_cvtsd_f64(x); }
+    static vec last(vec x) { return _mm_unpackhi_pd(x, x); }
+    static vec prefix(vec x)
+    {
+        return _mm_add_pd(x, _mm_castsi128_pd(_mm_slli_si128(_mm_castpd_si128(x), 8)));
+    }
+};
+
+template<class T>
+struct scan_sse2_int32
+{
+    typedef T type;
+    typedef __m128i vec;
+    static const std::size_t lanes = 4;
+
+    static vec load(const T * p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(T * p, vec x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    static vec add(vec x, vec y) { return _mm_add_epi32(x, y); }
+    static vec set1(T x) { return _mm_set1_epi32(static_cast<int>(x)); }
+    static T first(vec x) { return static_cast<T>(_mm_cvtsi128_si32(x)); }
+    static vec last(vec x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 3, 3, 3)); }
+    static vec prefix(vec x)
+    {
+        x = _mm_add_epi32(x, _mm_slli_si128(x, 4));
+        return _mm_add_epi32(x, _mm_slli_si128(x, 8));
+    }
+};
+
+template<class T>
+struct scan_sse2_int64
+{
+    typedef T type;
+    typedef __m128i vec;
+    static const std::size_t lanes = 2;
+
+    static vec load(const T * p) { return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+    static void store(T * p, vec x) { _mm_storeu_si128(reinterpret_cast<__m128i*>(p), x); }
+    static vec add(vec x, vec y) { return _mm_add_epi64(x, y); }
+    static vec set1(T x) { return _mm_set1_epi64x(static_cast<long long>(x)); }
+    static T first(vec x)
+    {
+        T r;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(&r), x);
+        return r;
+    }
+    static vec last(vec x) { return _mm_shuffle_epi32(x, _MM_SHUFFLE(3, 2, 3, 2)); }
+    static vec prefix(vec x)
+    {
+        return _mm_add_epi64(x, _mm_slli_si128(x, 8));
+    }
+};
+
+template<class T, class=void>
+struct scan_sse2
+{};
+
+template<>
+struct scan_sse2<float>
+{
+    typedef scan_sse2_float type;
+};
+
+template<>
+struct scan_sse2<double>
+{
+    typedef scan_sse2_double type;
+};
+
+template<class T>
+struct scan_sse2<T, typename std::enable_if<(std::is_integral<T>::value && sizeof(T) == 4)>::type>
+{
+    typedef scan_sse2_int32<T> type;
+};
+
+template<class T>
+struct scan_sse2<T, typename std::enable_if<(std::is_integral<T>::value && sizeof(T) == 8)>::type>
+{
+    typedef scan_sse2_int64<T> type;
+};
+
+template<class Ops, class T>
+T * scan_add_simd(const T * p, std::size_t n, T * out, T state)
+{
+    typedef typename Ops::vec vec;
+    const std::size_t lanes = Ops::lanes;
+    std::size_t i = 0;
+    vec carry = Ops::set1(state);
+    // Each vector is scanned on its own, so only adding the carry depends
+    // on the previous iteration
+    for(;i + 2*lanes <= n;i += 2*lanes)
+    {
+        vec x = Ops::prefix(Ops::load(p + i));
+        vec y = Ops::prefix(Ops::load(p + i + lanes));
+        vec x_total = Ops::last(x);
+        Ops::store(out + i, Ops::add(x, carry));
+        Ops::store(out + i + lanes, Ops::add(y, Ops::add(carry, x_total)));
+        carry = Ops::add(carry, Ops::add(x_total, Ops::last(y)));
+    }
+    state = Ops::first(carry);
+    for(;i<n;i++)
+    {
+        state = state + p[i];
+        out[i] = state;
+    }
+    return out + n;
+}
+
+struct scan_range_simd
+{
+    template<class F, class State, class Range, class OutputIterator, class E=typename contiguous_element<Range>::type,
+        class Ops=typename scan_sse2<E>::type, class=typename std::enable_if<(
+        scan_is_add<F>::value && std::is_same<State, E>::value && std::is_same<OutputIterator, E*>::value
+    )>::type>
+    E * operator()(const F&, State state, const Range& r, OutputIterator out) const
+    {
+        return detail::scan_add_simd<Ops>(detail::contiguous_data(r), detail::contiguous_size(r), out, state);
+    }
+};
+#endif
+
+struct scan_range_loop
+{
+    template<class F, class State, class Range, class OutputIterator>
+    OutputIterator operator()(const F& f, State state, const Range& r, OutputIterator out) const
+    {
+        for(auto&& x:r)
+        {
+            state = f(fit::move(state), x);
+            *out = state;
+            ++out;
+        }
+        return out;
+    }
+};
+
+typedef conditional_adaptor<
+#if FIT_SCAN_SSE2
+    scan_range_simd,
+#endif
+    scan_range_loop
+> scan_range_f;
+
+}
+
+template<class F, class State>
+struct scan_adaptor
+: detail::compressed_pair<detail::callable_base<F>, State>
+{
+    typedef detail::compressed_pair<detail::callable_base<F>, State> base_type;
+    FIT_INHERIT_CONSTRUCTOR(scan_adaptor, base_type)
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr State get_state(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+    template<class... Ts, class=typename std::enable_if<(
+        detail::and_<detail::scan_step_is_callable<const detail::callable_base<F>&, State, Ts&&>...>::value
+    )>::type>
+    constexpr typename detail::scan_result<State, typename detail::gens<sizeof...(Ts)>::type>::type
+    operator()(Ts&&... xs) const
+    {
+        return detail::scan_fold<0, sizeof...(Ts), State>()(
+            this->base_function(xs...),
+            detail::indexed_refs<typename detail::gens<sizeof...(Ts)>::type, Ts...>(FIT_FORWARD(Ts)(xs)...),
+            this->get_state(xs...)
+        );
+    }
+};
+
+template<class F, class State>
+struct scan_range_adaptor
+: detail::compressed_pair<detail::callable_base<F>, State>
+{
+    typedef detail::compressed_pair<detail::callable_base<F>, State> base_type;
+    FIT_INHERIT_CONSTRUCTOR(scan_range_adaptor, base_type)
+
+    template<class... Ts>
+    constexpr const detail::callable_base<F>& base_function(Ts&&... xs) const
+    {
+        return this->first(xs...);
+    }
+
+    template<class... Ts>
+    constexpr State get_state(Ts&&... xs) const
+    {
+        return this->second(xs...);
+    }
+
+    template<class Range, class OutputIterator>
+    OutputIterator operator()(const Range& r, OutputIterator out) const
+    {
+        return detail::scan_range_f()(this->base_function(r), this->get_state(r), r, out);
+    }
+};
+
+FIT_DECLARE_STATIC_VAR(scan, detail::make<scan_adaptor>);
+FIT_DECLARE_STATIC_VAR(scan_range, detail::make<scan_range_adaptor>);
+
+} // namespace fit
+
+#endif
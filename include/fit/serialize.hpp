@@ -0,0 +1,1000 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    serialize.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_SERIALIZE_H
+#define FIT_GUARD_SERIALIZE_H
+
+/// serialize
+/// =========
+///
+/// Description
+/// -----------
+///
+/// The `serialize` function writes values as bytes into a buffer, and the
+/// `deserialize` function reads them back. A value is written depending on
+/// its type:
+///
+/// * Integers, enums, floating point numbers, and trivially copyable types
+///   without padding bits are copied as they are in memory.
+/// * A sequence that can be [unpacked](/include/fit/unpack), such as a
+///   `std::tuple`, a [`pack`](/include/fit/pack), or a type with an
+///   [`unpack_sequence`](/include/fit/unpack_sequence) specialisation, is
+///   written one field after another. When its fields are laid out in memory
+///   in the same order without gaps, it is copied at once instead.
+/// * A range is written as its size followed by its elements. When the
+///   range is contiguous and its elements are copied as they are, such as
+///   `std::string` or `std::vector<int>`, the elements are copied at once.
+/// * An empty type is not written.
+///
+/// The bytes use the layout and endianness of the platform, so they can only
+/// be read back on the same kind of platform. Pointers can't be written. A
+/// view, such as `std::string_view`, is written like the range it refers
+/// to, and can only be read back as a range that owns its elements, such as
+/// `std::string`.
+///
+/// `serialize(buffer)` returns a `byte_writer` over a contiguous buffer of
+/// bytes, which must stay alive while the writer is used. Calling the writer
+/// with values computes their size first, and then writes them all, or none
+/// of them when they don't fit in the rest of the buffer. It returns whether
+/// they were written.
+///
+/// `deserialize<T>(bytes)` reads a `T` from the start of a contiguous buffer
+/// of bytes. To read several values one after another, the buffer can be
+/// given as a `byte_reader`, which keeps its position. Sequences are rebuilt
+/// with [`construct`](/include/fit/construct) from each field, or with braces
+/// when they are aggregates, without an intermediate tuple. When there are
+/// not enough bytes, the reader is marked as failed and the missing bytes
+/// are read as zero.
+///
+/// A `byte_ring<N>` can be used instead of a buffer, to stream records
+/// through a fixed-size ring of `N` bytes, where `N` is a power of two. Each
+/// call of the writer adds a record at the end of the ring if there is room,
+/// and `deserialize` removes one from the front. A record that fails to be
+/// read is left in the ring, and `deserialize(ring, ok)` sets `ok` to false
+/// in that case. The ring isn't synchronized, so it must be used from one
+/// thread at a time.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Ts>
+///     std::size_t serialized_size(const Ts&... xs);
+///
+///     template<class Buffer>
+///     byte_writer serialize(Buffer& buffer);
+///
+///     template<std::size_t N>
+///     ring_writer<N> serialize(byte_ring<N>& ring);
+///
+///     template<class T, class Bytes>
+///     T deserialize(Bytes&& bytes);
+///
+///     template<class T, std::size_t N>
+///     T deserialize(byte_ring<N>& ring, bool& ok);
+///
+/// Requirements
+/// ------------
+///
+/// Buffer must be:
+///
+/// * An array or a container with `data()` and `size()` of a byte type
+///
+/// T must be:
+///
+/// * Serializable as described above
+/// * MoveConstructible
+/// * DefaultConstructible, when it is a range
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <string>
+///     #include <tuple>
+///     #include <vector>
+///
+///     int main() {
+///         std::vector<char> buffer(64);
+///         auto writer = fit::serialize(buffer);
+///         assert(writer(std::make_tuple(1, std::string("ab"), 2.5)));
+///         assert(writer.size() == fit::serialized_size(std::make_tuple(1, std::string("ab"), 2.5)));
+///
+///         auto t = fit::deserialize<std::tuple<int, std::string, double>>(buffer);
+///         assert(std::get<1>(t) == "ab");
+///     }
+///
+
+#include <fit/conditional.hpp>
+#include <fit/construct.hpp>
+#include <fit/is_callable.hpp>
+#include <fit/is_unpackable.hpp>
+#include <fit/returns.hpp>
+#include <fit/unpack.hpp>
+#include <fit/detail/and.hpp>
+#include <fit/detail/contiguous.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/intrinsics.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+
+namespace fit {
+
+template<std::size_t N>
+class byte_ring;
+
+template<std::size_t N>
+class ring_writer;
+
+namespace detail {
+
+template<class T, class=void>
+struct serialize_is_range
+: std::false_type
+{};
+
+template<class T>
+struct serialize_is_range<T, typename holder<
+    decltype(std::begin(std::declval<const T&>()))
+>::type>
+: std::true_type
+{};
+
+template<class T, class=void>
+struct serialize_has_tuple_size
+: std::false_type
+{};
+
+template<class T>
+struct serialize_has_tuple_size<T, typename holder<
+    decltype(std::tuple_size<T>::value)
+>::type>
+: std::true_type
+{};
+
+// A range that isn't a fixed-size array, such as `std::string_view`, only
+// points to its elements, so it can't be copied as it is
+template<class T>
+struct serialize_is_view
+: std::integral_constant<bool, (
+    serialize_is_range<T>::value && !std::is_array<T>::value && !serialize_has_tuple_size<T>::value
+)>
+{};
+
+template<class T>
+struct serialize_is_raw
+: std::integral_constant<bool, (
+    !std::is_pointer<T>::value && !std::is_member_pointer<T>::value && (
+        std::is_arithmetic<T>::value || std::is_enum<T>::value ||
+        (FIT_IS_TRIVIALLY_COPYABLE(T) && FIT_HAS_UNIQUE_REPRESENTATION(T) && !is_unpackable<T>::value && !serialize_is_view<T>::value)
+    )
+)>
+{};
+
+template<class T>
+struct serialize_is_empty
+: std::integral_constant<bool, (std::is_empty<T>::value && !is_unpackable<T>::value)>
+{};
+
+template<class T>
+struct serialize_is_fields
+: std::integral_constant<bool, (is_unpackable<T>::value && !serialize_is_raw<T>::value)>
+{};
+
+template<class T>
+struct serialize_is_byte
+: std::integral_constant<bool, (sizeof(T) == 1 && FIT_IS_TRIVIALLY_COPYABLE(T))>
+{};
+
+template<class... Ts>
+struct serialize_types
+{};
+
+struct serialize_types_f
+{
+    template<class... Ts>
+    constexpr serialize_types<typename std::decay<Ts>::type...> operator()(Ts&&...) const
+    {
+        return {};
+    }
+};
+
+template<class T>
+struct serialize_fields
+{
+    typedef decltype(fit::unpack(serialize_types_f())(std::declval<const T&>())) type;
+};
+
+template<std::size_t... Ns>
+struct serialize_sum
+: std::integral_constant<std::size_t, 0>
+{};
+
+template<std::size_t N, std::size_t... Ns>
+struct serialize_sum<N, Ns...>
+: std::integral_constant<std::size_t, N + serialize_sum<Ns...>::value>
+{};
+
+// Whether every value of the type is written with the same number of bytes
+template<class T, class=void>
+struct serialize_fixed
+{
+    static const bool value = false;
+    static const std::size_t size = 0;
+};
+
+template<class Fields>
+struct serialize_fixed_fields;
+
+template<class... Ts>
+struct serialize_fixed_fields<serialize_types<Ts...>>
+{
+    static const bool value = FIT_AND_UNPACK(serialize_fixed<Ts>::value);
+    static const std::size_t size = serialize_sum<serialize_fixed<Ts>::size...>::value;
+};
+
+template<class T>
+struct serialize_fixed<T, typename std::enable_if<serialize_is_raw<T>::value>::type>
+{
+    static const bool value = true;
+    static const std::size_t size = sizeof(T);
+};
+
+template<class T>
+struct serialize_fixed<T, typename std::enable_if<serialize_is_empty<T>::value>::type>
+{
+    static const bool value = true;
+    static const std::size_t size = 0;
+};
+
+template<class T>
+struct serialize_fixed<T, typename std::enable_if<serialize_is_fields<T>::value>::type>
+: serialize_fixed_fields<typename serialize_fields<T>::type>
+{};
+
+template<class Range>
+auto serialize_data(Range& r) FIT_RETURNS(r.data());
+
+template<class T, std::size_t N>
+T * serialize_data(T (&a)[N])
+{
+    return a;
+}
+
+template<class Range, class=void>
+struct serialize_has_size
+: std::false_type
+{};
+
+template<class Range>
+struct serialize_has_size<Range, typename holder<
+    decltype(std::declval<const Range&>().size())
+>::type>
+: std::true_type
+{};
+
+template<class Range>
+std::size_t serialize_count(std::true_type, const Range& r)
+{
+    return r.size();
+}
+
+template<class Range>
+std::size_t serialize_count(std::false_type, const Range& r)
+{
+    using std::begin;
+    using std::end;
+    return std::distance(begin(r), end(r));
+}
+
+template<class Range>
+std::size_t serialize_count(const Range& r)
+{
+    return detail::serialize_count(serialize_has_size<Range>(), r);
+}
+
+template<class Range, class=void>
+struct serialize_element
+{};
+
+template<class Range>
+struct serialize_element<Range, typename holder<
+    decltype(*std::begin(std::declval<const Range&>()))
+>::type>
+{
+    typedef typename std::decay<decltype(*std::begin(std::declval<const Range&>()))>::type type;
+};
+
+// Writes into a space that is known to be big enough
+struct serialize_buffer_sink
+{
+    unsigned char * pos;
+
+    void write(const void * p, std::size_t n)
+    {
+        std::memcpy(pos, p, n);
+        pos += n;
+    }
+};
+
+struct serialize_size_f;
+struct serialize_write_f;
+
+struct serialize_size_raw
+{
+    template<class T, class=typename std::enable_if<serialize_is_raw<T>::value>::type>
+    constexpr std::size_t operator()(const T&) const
+    {
+        return sizeof(T);
+    }
+};
+
+struct serialize_size_empty
+{
+    template<class T, class=typename std::enable_if<serialize_is_empty<T>::value>::type>
+    constexpr std::size_t operator()(const T&) const
+    {
+        return 0;
+    }
+};
+
+struct serialize_size_sum
+{
+    template<class... Ts, class=typename std::enable_if<
+        and_<is_callable<serialize_size_f, const Ts&>...>::value
+    >::type>
+    std::size_t operator()(const Ts&... xs) const;
+};
+
+struct serialize_size_fields
+{
+    template<class T, class=typename std::enable_if<(serialize_is_fields<T>::value && serialize_fixed<T>::value)>::type>
+    constexpr std::size_t operator()(const T&) const
+    {
+        return serialize_fixed<T>::size;
+    }
+
+    template<class T, class=typename std::enable_if<(serialize_is_fields<T>::value && !serialize_fixed<T>::value)>::type, class=typename std::enable_if<
+        is_callable<unpack_adaptor<serialize_size_sum>, const T&>::value
+    >::type>
+    std::size_t operator()(const T& x) const
+    {
+        return fit::unpack(serialize_size_sum())(x);
+    }
+};
+
+struct serialize_size_contiguous
+{
+    template<class T, class E=typename contiguous_element<T>::type, class=typename std::enable_if<
+        serialize_is_raw<E>::value && !is_unpackable<T>::value
+    >::type>
+    std::size_t operator()(const T& x) const
+    {
+        return sizeof(std::uint64_t) + detail::contiguous_size(x)*sizeof(E);
+    }
+};
+
+struct serialize_size_range
+{
+    template<class T, class E=typename serialize_element<T>::type, class=typename std::enable_if<
+        is_callable<serialize_size_f, const E&>::value && !is_unpackable<T>::value
+    >::type>
+    std::size_t operator()(const T& x) const
+    {
+        std::size_t n = sizeof(std::uint64_t);
+        for(auto&& e:x) n += serialize_size_f()(e);
+        return n;
+    }
+};
+
+struct serialize_size_f
+: conditional_adaptor<
+    serialize_size_raw,
+    serialize_size_empty,
+    serialize_size_fields,
+    serialize_size_contiguous,
+    serialize_size_range
+>
+{};
+
+template<class... Ts, class>
+std::size_t serialize_size_sum::operator()(const Ts&... xs) const
+{
+    std::size_t n = 0;
+    (void)std::initializer_list<int>{(n += serialize_size_f()(xs), 0)...};
+    return n;
+}
+
+// Checks that the fields follow each other in memory without gaps, which
+// is folded to a constant once inlined
+struct serialize_flat_f
+{
+    const unsigned char * base;
+
+    template<class... Ts>
+    bool operator()(const Ts&... xs) const
+    {
+        bool flat = true;
+        std::size_t offset = 0;
+        (void)std::initializer_list<int>{(
+            flat = flat && serialize_is_raw<Ts>::value && reinterpret_cast<const unsigned char*>(&xs) == base + offset,
+            offset += sizeof(Ts),
+        0)...};
+        return flat;
+    }
+};
+
+template<class T>
+bool serialize_flat(std::true_type, const T& x)
+{
+    return fit::unpack(serialize_flat_f{reinterpret_cast<const unsigned char*>(&x)})(x);
+}
+
+template<class T>
+bool serialize_flat(std::false_type, const T&)
+{
+    return false;
+}
+
+template<class T>
+bool serialize_flat(const T& x)
+{
+    return detail::serialize_flat(std::integral_constant<bool, (
+        FIT_IS_TRIVIALLY_COPYABLE(T) && serialize_fixed<T>::value && serialize_fixed<T>::size == sizeof(T)
+    )>(), x);
+}
+
+template<class Sink>
+struct serialize_write_fields_f
+{
+    Sink * sink;
+
+    template<class... Ts>
+    void operator()(const Ts&... xs) const
+    {
+        (void)std::initializer_list<int>{(serialize_write_f()(*sink, xs), 0)...};
+    }
+};
+
+struct serialize_write_raw
+{
+    template<class Sink, class T, class=typename std::enable_if<serialize_is_raw<T>::value>::type>
+    void operator()(Sink& s, const T& x) const
+    {
+        s.write(&x, sizeof(T));
+    }
+};
+
+struct serialize_write_empty
+{
+    template<class Sink, class T, class=typename std::enable_if<serialize_is_empty<T>::value>::type>
+    void operator()(Sink&, const T&) const
+    {}
+};
+
+struct serialize_write_fields
+{
+    template<class Sink, class T, class=typename std::enable_if<serialize_is_fields<T>::value>::type>
+    void operator()(Sink& s, const T& x) const
+    {
+        if (detail::serialize_flat(x)) s.write(&x, sizeof(T));
+        else fit::unpack(serialize_write_fields_f<Sink>{&s})(x);
+    }
+};
+
+struct serialize_write_contiguous
+{
+    template<class Sink, class T, class E=typename contiguous_element<T>::type, class=typename std::enable_if<
+        serialize_is_raw<E>::value && !is_unpackable<T>::value
+    >::type>
+    void operator()(Sink& s, const T& x) const
+    {
+        std::uint64_t n = detail::contiguous_size(x);
+        s.write(&n, sizeof(n));
+        if (n > 0) s.write(detail::contiguous_data(x), n*sizeof(E));
+    }
+};
+
+struct serialize_write_range
+{
+    template<class Sink, class T, class E=typename serialize_element<T>::type, class=typename std::enable_if<
+        is_callable<serialize_size_f, const E&>::value && !is_unpackable<T>::value
+    >::type>
+    void operator()(Sink& s, const T& x) const
+    {
+        std::uint64_t n = detail::serialize_count(x);
+        s.write(&n, sizeof(n));
+        for(auto&& e:x) serialize_write_f()(s, e);
+    }
+};
+
+struct serialize_write_f
+: conditional_adaptor<
+    serialize_write_raw,
+    serialize_write_empty,
+    serialize_write_fields,
+    serialize_write_contiguous,
+    serialize_write_range
+>
+{};
+
+template<class Sink, class... Ts>
+void serialize_write_all(Sink& s, const Ts&... xs)
+{
+    (void)std::initializer_list<int>{(serialize_write_f()(s, xs), 0)...};
+}
+
+// Reads from a space that is known to be big enough
+struct serialize_unchecked_source
+{
+    const unsigned char * pos;
+
+    bool read(void * p, std::size_t n)
+    {
+        std::memcpy(p, pos, n);
+        pos += n;
+        return true;
+    }
+
+    std::size_t remaining() const
+    {
+        return std::size_t(-1);
+    }
+
+    const unsigned char * contiguous(std::size_t) const
+    {
+        return pos;
+    }
+
+    void skip(std::size_t n)
+    {
+        pos += n;
+    }
+
+    bool ok() const
+    {
+        return true;
+    }
+};
+
+template<class T>
+struct serialize_type
+{};
+
+template<class T, class Source>
+T serialize_read(Source& s);
+
+template<class T, class... Ts, typename std::enable_if<FIT_IS_CONSTRUCTIBLE(T, Ts&&...), int>::type = 0>
+T serialize_make(Ts&&... xs)
+{
+    return fit::construct<T>()(FIT_FORWARD(Ts)(xs)...);
+}
+
+template<class T, class... Ts, typename std::enable_if<!FIT_IS_CONSTRUCTIBLE(T, Ts&&...), int>::type = 0>
+T serialize_make(Ts&&... xs)
+{
+    return T{FIT_FORWARD(Ts)(xs)...};
+}
+
+// Each field is read into a parameter of the next step, so the fields are
+// read in order and then moved into the object
+template<class T, class Source, class... Ts>
+T serialize_read_fields(Source&, serialize_types<>, Ts&&... xs)
+{
+    return detail::serialize_make<T>(FIT_FORWARD(Ts)(xs)...);
+}
+
+template<class T, class Source, class U, class... Us, class... Ts>
+T serialize_read_fields(Source& s, serialize_types<U, Us...>, Ts&&... xs)
+{
+    U x = detail::serialize_read<U>(s);
+    return detail::serialize_read_fields<T>(s, serialize_types<Us...>(), FIT_FORWARD(Ts)(xs)..., fit::move(x));
+}
+
+struct serialize_read_raw
+{
+    template<class Source, class T, class=typename std::enable_if<serialize_is_raw<T>::value>::type>
+    T operator()(Source& s, serialize_type<T>) const
+    {
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+        s.read(&storage, sizeof(T));
+        return *reinterpret_cast<T*>(&storage);
+    }
+};
+
+struct serialize_read_empty
+{
+    template<class Source, class T, class=typename std::enable_if<serialize_is_empty<T>::value>::type>
+    T operator()(Source&, serialize_type<T>) const
+    {
+        return T();
+    }
+};
+
+struct serialize_read_fields_f
+{
+    template<class Source, class T, class=typename std::enable_if<serialize_is_fields<T>::value>::type>
+    T operator()(Source& s, serialize_type<T>) const
+    {
+        return detail::serialize_read_fields<T>(s, typename serialize_fields<T>::type());
+    }
+};
+
+struct serialize_read_contiguous
+{
+    template<class Source, class T, class E=typename contiguous_element<T>::type, class=typename std::enable_if<(
+        serialize_is_raw<E>::value && !is_unpackable<T>::value
+    )>::type, class=decltype(std::declval<T&>().resize(0)), class=decltype(std::declval<T&>()[0])>
+    T operator()(Source& s, serialize_type<T>) const
+    {
+        std::uint64_t n = detail::serialize_read<std::uint64_t>(s);
+        T r;
+        // Check the size first, so a bad size doesn't allocate
+        if (n > s.remaining() / sizeof(E))
+        {
+            s.skip(s.remaining() + 1);
+            return r;
+        }
+        r.resize(n);
+        if (n > 0) s.read(&r[0], n*sizeof(E));
+        return r;
+    }
+};
+
+struct serialize_read_range
+{
+    template<class Source, class T, class E=typename serialize_element<T>::type, class=typename std::enable_if<(
+        !is_unpackable<T>::value
+    )>::type, class=decltype(std::declval<T&>().insert(std::declval<T&>().end(), std::declval<E>()))>
+    T operator()(Source& s, serialize_type<T>) const
+    {
+        std::uint64_t n = detail::serialize_read<std::uint64_t>(s);
+        T r;
+        for(std::uint64_t i=0;i<n && s.ok();i++) r.insert(r.end(), detail::serialize_read<E>(s));
+        if (!s.ok()) return T();
+        return r;
+    }
+};
+
+struct serialize_read_f
+: conditional_adaptor<
+    serialize_read_raw,
+    serialize_read_empty,
+    serialize_read_fields_f,
+    serialize_read_contiguous,
+    serialize_read_range
+>
+{};
+
+template<class T, class Source>
+T serialize_read(Source& s)
+{
+    return serialize_read_f()(s, serialize_type<T>());
+}
+
+// A value of fixed size is checked once, and then read without checks
+template<class T, class Source>
+T serialize_read_checked(std::true_type, Source& s)
+{
+    const std::size_t n = serialize_fixed<T>::size;
+    const unsigned char * p = s.contiguous(n);
+    if (p == nullptr) return detail::serialize_read<T>(s);
+    serialize_unchecked_source u = { p };
+    T r = detail::serialize_read<T>(u);
+    s.skip(n);
+    return r;
+}
+
+template<class T, class Source>
+T serialize_read_checked(std::false_type, Source& s)
+{
+    return detail::serialize_read<T>(s);
+}
+
+template<class T, class Source>
+T serialize_read_checked(Source& s)
+{
+    return detail::serialize_read_checked<T>(std::integral_constant<bool, serialize_fixed<T>::value>(), s);
+}
+
+template<class T, class=void>
+struct is_serializable
+: std::false_type
+{};
+
+template<class T>
+struct is_serializable<T, typename std::enable_if<is_callable<serialize_size_f, const T&>::value>::type>
+: std::true_type
+{};
+
+struct serialized_size_f
+{
+    template<class... Ts, class=typename std::enable_if<and_<is_serializable<Ts>...>::value>::type>
+    std::size_t operator()(const Ts&... xs) const
+    {
+        return serialize_size_sum()(xs...);
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(serialized_size, detail::serialized_size_f);
+
+class byte_writer
+{
+    unsigned char * first;
+    unsigned char * pos;
+    unsigned char * last;
+public:
+    byte_writer(unsigned char * p, std::size_t n) : first(p), pos(p), last(p + n)
+    {}
+
+    template<class... Ts, class=typename std::enable_if<detail::and_<detail::is_serializable<Ts>...>::value>::type>
+    bool operator()(const Ts&... xs)
+    {
+        std::size_t n = serialized_size(xs...);
+        if (n > std::size_t(last - pos)) return false;
+        detail::serialize_buffer_sink sink = { pos };
+        detail::serialize_write_all(sink, xs...);
+        pos += n;
+        return true;
+    }
+
+    const unsigned char * data() const
+    {
+        return first;
+    }
+
+    std::size_t size() const
+    {
+        return pos - first;
+    }
+};
+
+class byte_reader
+{
+    const unsigned char * pos;
+    const unsigned char * last;
+    bool failed;
+public:
+    byte_reader(const void * p, std::size_t n)
+    : pos(static_cast<const unsigned char*>(p)), last(pos + n), failed(false)
+    {}
+
+    template<class Bytes, class E=typename detail::contiguous_element<Bytes>::type, class=typename std::enable_if<
+        detail::serialize_is_byte<E>::value
+    >::type>
+    byte_reader(const Bytes& b)
+    : pos(reinterpret_cast<const unsigned char*>(detail::contiguous_data(b))), last(pos + detail::contiguous_size(b)), failed(false)
+    {}
+
+    bool read(void * p, std::size_t n)
+    {
+        if (n > this->remaining())
+        {
+            std::memset(p, 0, n);
+            this->skip(n);
+            return false;
+        }
+        std::memcpy(p, pos, n);
+        pos += n;
+        return true;
+    }
+
+    std::size_t remaining() const
+    {
+        return last - pos;
+    }
+
+    const unsigned char * contiguous(std::size_t n) const
+    {
+        return n <= this->remaining() ? pos : nullptr;
+    }
+
+    void skip(std::size_t n)
+    {
+        if (n > this->remaining())
+        {
+            pos = last;
+            failed = true;
+        }
+        else pos += n;
+    }
+
+    bool ok() const
+    {
+        return !failed;
+    }
+};
+
+template<std::size_t N>
+class byte_ring
+{
+    static_assert(N > 0 && (N & (N - 1)) == 0, "The size of a byte_ring must be a power of two");
+    unsigned char storage[N];
+    std::size_t head;
+    std::size_t tail;
+
+    template<std::size_t>
+    friend class ring_writer;
+
+    template<class T, std::size_t M>
+    friend T deserialize(byte_ring<M>&, bool&);
+
+    struct sink
+    {
+        byte_ring * ring;
+        std::size_t pos;
+
+        void write(const void * p, std::size_t n)
+        {
+            std::size_t i = pos & (N - 1);
+            std::size_t first = n < N - i ? n : N - i;
+            std::memcpy(ring->storage + i, p, first);
+            std::memcpy(ring->storage, static_cast<const unsigned char*>(p) + first, n - first);
+            pos += n;
+        }
+    };
+
+    struct source
+    {
+        byte_ring * ring;
+        std::size_t pos;
+        bool failed;
+
+        bool read(void * p, std::size_t n)
+        {
+            if (n > this->remaining())
+            {
+                std::memset(p, 0, n);
+                this->skip(n);
+                return false;
+            }
+            std::size_t i = pos & (N - 1);
+            std::size_t first = n < N - i ? n : N - i;
+            std::memcpy(p, ring->storage + i, first);
+            std::memcpy(static_cast<unsigned char*>(p) + first, ring->storage, n - first);
+            pos += n;
+            return true;
+        }
+
+        std::size_t remaining() const
+        {
+            return ring->tail - pos;
+        }
+
+        const unsigned char * contiguous(std::size_t n) const
+        {
+            std::size_t i = pos & (N - 1);
+            return (n <= this->remaining() && n <= N - i) ? ring->storage + i : nullptr;
+        }
+
+        void skip(std::size_t n)
+        {
+            if (n > this->remaining())
+            {
+                pos = ring->tail;
+                failed = true;
+            }
+            else pos += n;
+        }
+
+        bool ok() const
+        {
+            return !failed;
+        }
+    };
+public:
+    byte_ring() : head(0), tail(0)
+    {}
+
+    byte_ring(const byte_ring&) = delete;
+    byte_ring& operator=(const byte_ring&) = delete;
+
+    std::size_t size() const
+    {
+        return tail - head;
+    }
+
+    bool empty() const
+    {
+        return head == tail;
+    }
+
+    static constexpr std::size_t capacity()
+    {
+        return N;
+    }
+};
+
+template<std::size_t N>
+class ring_writer
+{
+    byte_ring<N> * ring;
+public:
+    ring_writer(byte_ring<N>& r) : ring(&r)
+    {}
+
+    template<class... Ts, class=typename std::enable_if<detail::and_<detail::is_serializable<Ts>...>::value>::type>
+    bool operator()(const Ts&... xs)
+    {
+        std::size_t n = serialized_size(xs...);
+        if (n > N - ring->size()) return false;
+        std::size_t i = ring->tail & (N - 1);
+        // Records that don't wrap around are written directly
+        if (n <= N - i)
+        {
+            detail::serialize_buffer_sink sink = { ring->storage + i };
+            detail::serialize_write_all(sink, xs...);
+        }
+        else
+        {
+            typename byte_ring<N>::sink sink = { ring, ring->tail };
+            detail::serialize_write_all(sink, xs...);
+        }
+        ring->tail += n;
+        return true;
+    }
+};
+
+template<class Buffer, class E=typename detail::contiguous_element<Buffer>::type, class=typename std::enable_if<
+    detail::serialize_is_byte<E>::value
+>::type>
+byte_writer serialize(Buffer& b)
+{
+    return byte_writer(reinterpret_cast<unsigned char*>(detail::serialize_data(b)), detail::contiguous_size(b));
+}
+
+template<std::size_t N>
+ring_writer<N> serialize(byte_ring<N>& r)
+{
+    return ring_writer<N>(r);
+}
+
+template<class T>
+T deserialize(byte_reader& r)
+{
+    return detail::serialize_read_checked<T>(r);
+}
+
+template<class T, class Bytes, class=typename std::enable_if<
+    std::is_constructible<byte_reader, const Bytes&>::value && !std::is_same<typename std::decay<Bytes>::type, byte_reader>::value
+>::type>
+T deserialize(const Bytes& b)
+{
+    byte_reader r(b);
+    return detail::serialize_read_checked<T>(r);
+}
+
+template<class T, std::size_t N>
+T deserialize(byte_ring<N>& ring, bool& ok)
+{
+    typename byte_ring<N>::source s = { &ring, ring.head, false };
+    T r = detail::serialize_read_checked<T>(s);
+    ok = s.ok();
+    if (ok) ring.head = s.pos;
+    return r;
+}
+
+template<class T, std::size_t N>
+T deserialize(byte_ring<N>& ring)
+{
+    bool ok;
+    return fit::deserialize<T>(ring, ok);
+}
+
+} // namespace fit
+
+#endif
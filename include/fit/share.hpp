@@ -0,0 +1,215 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    share.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_SHARE_H
+#define FIT_GUARD_SHARE_H
+
+/// share
+/// =====
+///
+/// Description
+/// -----------
+///
+/// The `share` function moves a value into a single immutable block with an
+/// intrusive reference count, and returns a `shared` handle to it. Copying
+/// the handle only increments the reference count, so closures that carry
+/// large state, such as lookup tables, can be copied cheaply.
+///
+/// When a `shared` handle is captured with `pack`, `capture`, `partial` or
+/// `pipable`, the function is called with a const reference to the shared
+/// value instead of the handle.
+///
+/// The reference count is atomic, unless `FIT_SINGLE_THREADED` is enabled, in
+/// which case a plain integer is used.
+///
+/// Synopsis
+/// --------
+///
+///     template<class T>
+///     class shared;
+///
+///     template<class T>
+///     shared<T> share(T&& x);
+///
+/// Semantics
+/// ---------
+///
+///     assert(capture(share(x))(f)(xs...) == f(x, xs...));
+///
+/// Requirements
+/// ------------
+///
+/// T must be:
+///
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <vector>
+///
+///     struct lookup
+///     {
+///         int operator()(const std::vector<int>& table, int i) const
+///         {
+///             return table[i];
+///         }
+///     };
+///
+///     int main() {
+///         auto f = fit::capture(fit::share(std::vector<int>(1024, 3)))(lookup());
+///         auto g = f;
+///         assert(g(1) == 3);
+///     }
+///
+
+#include <fit/config.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/pack_indirect.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <type_traits>
+#if !FIT_SINGLE_THREADED
+#include <atomic>
+#endif
+
+namespace fit {
+
+namespace detail {
+
+template<class T>
+struct shared_block
+{
+#if FIT_SINGLE_THREADED
+    std::size_t count;
+#else
+    std::atomic<std::size_t> count;
+#endif
+    const T value;
+
+    template<class X>
+    shared_block(X&& x) : count(1), value(FIT_FORWARD(X)(x))
+    {}
+
+    void retain()
+    {
+#if FIT_SINGLE_THREADED
+        ++count;
+#else
+        count.fetch_add(1, std::memory_order_relaxed);
+#endif
+    }
+
+    bool release()
+    {
+#if FIT_SINGLE_THREADED
+        return --count == 0;
+#else
+        return count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+#endif
+    }
+};
+
+}
+
+template<class T>
+class shared
+{
+    typedef detail::shared_block<T> block_type;
+    block_type * block;
+public:
+    typedef T element_type;
+
+    template<class X, typename std::enable_if<(
+        !std::is_same<typename std::decay<X>::type, shared>::value &&
+        std::is_constructible<T, X&&>::value
+    ), int>::type = 0>
+    explicit shared(X&& x) : block(new block_type(FIT_FORWARD(X)(x)))
+    {}
+
+    shared(const shared& rhs) : block(rhs.block)
+    {
+        if (block) block->retain();
+    }
+
+    shared(shared&& rhs) noexcept : block(rhs.block)
+    {
+        rhs.block = nullptr;
+    }
+
+    shared& operator=(shared rhs) noexcept
+    {
+        block_type * old = block;
+        block = rhs.block;
+        rhs.block = old;
+        return *this;
+    }
+
+    ~shared()
+    {
+        if (block && block->release()) delete block;
+    }
+
+    const T& get() const
+    {
+        return block->value;
+    }
+
+    const T& operator*() const
+    {
+        return block->value;
+    }
+
+    const T* operator->() const
+    {
+        return &block->value;
+    }
+
+    operator const T&() const
+    {
+        return block->value;
+    }
+
+    std::size_t use_count() const
+    {
+        return block ? static_cast<std::size_t>(block->count) : 0;
+    }
+};
+
+namespace detail {
+
+// Shared values are passed by reference to the value in the shared block
+template<class T>
+struct pack_indirect<shared<T>>
+: std::true_type
+{
+    typedef const T& type;
+
+    static constexpr const T& get(const shared<T>& x)
+    {
+        return x.get();
+    }
+};
+
+struct share_f
+{
+    template<class T, class Result=shared<typename std::decay<T>::type>>
+    Result operator()(T&& x) const
+    {
+        return Result(FIT_FORWARD(T)(x));
+    }
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(share, detail::share_f);
+
+} // namespace fit
+
+#endif
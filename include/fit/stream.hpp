@@ -0,0 +1,438 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    stream.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_STREAM_H
+#define FIT_GUARD_STREAM_H
+
+/// stream
+/// ======
+///
+/// Description
+/// -----------
+///
+/// The functions in the `stream` namespace build lazy pipelines over the
+/// elements of a range. Each stage is [`pipable`](/include/fit/pipable), so
+/// a pipeline is written by piping a range into the stages:
+///
+///     int r = v | stream::filter(_1 > 0) | stream::map(_1 * 2) | stream::fold(_1 + _2, 0);
+///
+/// The stages don't do anything until the pipeline ends in `fold` or
+/// `for_each`. Then each stage wraps the function of the next stage, and
+/// the elements are pushed through all of them in a single loop over the
+/// range, so there are no containers between the stages, and since every
+/// stage is a distinct type, the compiler can inline the whole pipeline.
+///
+/// * `map(f)` passes `f(x)` on for each element `x`.
+/// * `filter(p)` passes on the elements where `p(x)` is true.
+/// * `take(n)` passes on the first `n` elements, and stops the loop after
+///   that, so no more elements are read from the range.
+/// * `flat_map(f)` passes on each element of `f(x)`, which can be a range or
+///   another pipeline.
+/// * `fold(f, init)` calls `f(state, x)` for each element, starting from
+///   `init`, and returns the final state, which has the type of `init`.
+/// * `for_each(f)` calls `f(x)` for each element.
+///
+/// The functions can be any callable, including placeholder expressions.
+/// A pipeline holds a reference to a range that is an lvalue, and moves a
+/// range that is an rvalue into the pipeline, so it can be stored and run
+/// later, as long as an lvalue range outlives it.
+///
+/// Synopsis
+/// --------
+///
+///     namespace stream {
+///
+///     template<class Range, class F>
+///     stream_pipeline map(Range&& r, F f);
+///
+///     template<class Range, class F>
+///     stream_pipeline filter(Range&& r, F f);
+///
+///     template<class Range>
+///     stream_pipeline take(Range&& r, std::size_t n);
+///
+///     template<class Range, class F>
+///     stream_pipeline flat_map(Range&& r, F f);
+///
+///     template<class Range, class F, class State>
+///     State fold(Range&& r, F f, State init);
+///
+///     template<class Range, class F>
+///     void for_each(Range&& r, F f);
+///
+///     }
+///
+/// Semantics
+/// ---------
+///
+///     assert((r | stream::map(f) | stream::fold(g, z)) == std::accumulate(begin(r), end(r), z, flow(g, f)));
+///     assert((r | stream::filter(p) | stream::fold(g, z)) == std::accumulate(begin(r), end(r), z, [](auto s, auto x) { return p(x) ? g(s, x) : s; }));
+///
+/// Requirements
+/// ------------
+///
+/// Range must be:
+///
+/// * A range with `begin` and `end`, or a pipeline
+///
+/// F must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <vector>
+///     using namespace fit;
+///
+///     struct copies
+///     {
+///         std::vector<int> operator()(int x) const
+///         {
+///             return std::vector<int>(x, x);
+///         }
+///     };
+///
+///     int main() {
+///         std::vector<int> v = { 1, 2, 3, 4, 5, 6 };
+///         int r = v
+///             | stream::filter(_1 > 2)
+///             | stream::map(_1 * 10)
+///             | stream::fold(_1 + _2, 0);
+///         assert(r == 180);
+///
+///         auto first = v | stream::flat_map(copies()) | stream::take(4);
+///         assert((first | stream::fold(_1 + _2, 0)) == 1 + 2 + 2 + 3);
+///     }
+///
+
+#include <fit/pipable.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/delegate.hpp>
+#include <fit/detail/forward.hpp>
+#include <fit/detail/holder.hpp>
+#include <fit/detail/move.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+namespace fit {
+
+namespace detail {
+
+template<class Source, class Stage>
+struct stream_pipeline;
+
+template<class T>
+struct is_stream_pipeline
+: std::false_type
+{};
+
+template<class Source, class Stage>
+struct is_stream_pipeline<stream_pipeline<Source, Stage>>
+: std::true_type
+{};
+
+namespace stream_adl {
+
+using std::begin;
+using std::end;
+
+template<class Range>
+auto stream_begin(Range&& r) FIT_RETURNS(begin(r));
+
+template<class Range>
+auto stream_end(Range&& r) FIT_RETURNS(end(r));
+
+}
+
+template<class T, class=void>
+struct is_stream_range
+: std::false_type
+{};
+
+template<class T>
+struct is_stream_range<T, typename holder<
+    decltype(stream_adl::stream_begin(std::declval<T&>())),
+    decltype(stream_adl::stream_end(std::declval<T&>()))
+>::type>
+: std::true_type
+{};
+
+template<class T>
+struct is_stream_source
+: std::integral_constant<bool, (
+    is_stream_pipeline<typename std::decay<T>::type>::value || is_stream_range<T>::value
+)>
+{};
+
+// A sink is called with each element, and returns false to stop the loop
+template<class Range, class Sink, typename std::enable_if<(
+    !is_stream_pipeline<typename std::decay<Range>::type>::value
+), int>::type = 0>
+bool stream_run(Range&& r, Sink& sink)
+{
+    auto first = stream_adl::stream_begin(r);
+    auto last = stream_adl::stream_end(r);
+    for(;first != last;++first)
+    {
+        if (!sink(*first)) return false;
+    }
+    return true;
+}
+
+template<class Source, class Stage, class Sink>
+bool stream_run(const stream_pipeline<Source, Stage>& p, Sink& sink)
+{
+    return p.stage.run(p.source, sink);
+}
+
+template<class Source, class Stage>
+struct stream_pipeline
+{
+    Source source;
+    Stage stage;
+
+    template<class S, class T>
+    stream_pipeline(S&& s, T&& t) : source(FIT_FORWARD(S)(s)), stage(FIT_FORWARD(T)(t))
+    {}
+};
+
+// Lvalue ranges are held by reference, and everything else by value
+template<class Range>
+struct stream_source
+{
+    typedef typename std::conditional<
+        std::is_lvalue_reference<Range>::value && !is_stream_pipeline<typename std::decay<Range>::type>::value,
+        Range,
+        typename std::decay<Range>::type
+    >::type type;
+};
+
+template<class Range, class Stage>
+stream_pipeline<typename stream_source<Range&&>::type, Stage> make_stream_pipeline(Range&& r, Stage s)
+{
+    return stream_pipeline<typename stream_source<Range&&>::type, Stage>(FIT_FORWARD(Range)(r), fit::move(s));
+}
+
+template<class F, class Sink>
+struct stream_map_sink
+{
+    const F& f;
+    Sink& sink;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        return sink(f(FIT_FORWARD(T)(x)));
+    }
+};
+
+template<class F>
+struct stream_map_stage
+{
+    callable_base<F> f;
+
+    template<class Source, class Sink>
+    bool run(const Source& s, Sink& sink) const
+    {
+        stream_map_sink<callable_base<F>, Sink> next = { f, sink };
+        return detail::stream_run(s, next);
+    }
+};
+
+template<class F, class Sink>
+struct stream_filter_sink
+{
+    const F& f;
+    Sink& sink;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        if (f(x)) return sink(FIT_FORWARD(T)(x));
+        return true;
+    }
+};
+
+template<class F>
+struct stream_filter_stage
+{
+    callable_base<F> f;
+
+    template<class Source, class Sink>
+    bool run(const Source& s, Sink& sink) const
+    {
+        stream_filter_sink<callable_base<F>, Sink> next = { f, sink };
+        return detail::stream_run(s, next);
+    }
+};
+
+template<class Sink>
+struct stream_take_sink
+{
+    std::size_t n;
+    Sink& sink;
+    bool stopped;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        --n;
+        if (!sink(FIT_FORWARD(T)(x)))
+        {
+            stopped = true;
+            return false;
+        }
+        return n != 0;
+    }
+};
+
+struct stream_take_stage
+{
+    std::size_t n;
+
+    template<class Source, class Sink>
+    bool run(const Source& s, Sink& sink) const
+    {
+        if (n == 0) return true;
+        stream_take_sink<Sink> next = { n, sink, false };
+        detail::stream_run(s, next);
+        // Only a stop from further down stops an enclosing loop
+        return !next.stopped;
+    }
+};
+
+template<class F, class Sink>
+struct stream_flat_map_sink
+{
+    const F& f;
+    Sink& sink;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        return detail::stream_run(f(FIT_FORWARD(T)(x)), sink);
+    }
+};
+
+template<class F>
+struct stream_flat_map_stage
+{
+    callable_base<F> f;
+
+    template<class Source, class Sink>
+    bool run(const Source& s, Sink& sink) const
+    {
+        stream_flat_map_sink<callable_base<F>, Sink> next = { f, sink };
+        return detail::stream_run(s, next);
+    }
+};
+
+template<class F, class State>
+struct stream_fold_sink
+{
+    const F& f;
+    State state;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        state = f(fit::move(state), FIT_FORWARD(T)(x));
+        return true;
+    }
+};
+
+template<class F>
+struct stream_for_each_sink
+{
+    const F& f;
+
+    template<class T>
+    bool operator()(T&& x)
+    {
+        f(FIT_FORWARD(T)(x));
+        return true;
+    }
+};
+
+#define FIT_STREAM_REQUIRE_SOURCE(Range) \
+    class=typename std::enable_if<fit::detail::is_stream_source<Range>::value>::type
+
+struct stream_map_f
+{
+    template<class Range, class F, FIT_STREAM_REQUIRE_SOURCE(Range)>
+    auto operator()(Range&& r, F f) const FIT_RETURNS
+    (detail::make_stream_pipeline(FIT_FORWARD(Range)(r), stream_map_stage<F>{ fit::move(f) }));
+};
+
+struct stream_filter_f
+{
+    template<class Range, class F, FIT_STREAM_REQUIRE_SOURCE(Range)>
+    auto operator()(Range&& r, F f) const FIT_RETURNS
+    (detail::make_stream_pipeline(FIT_FORWARD(Range)(r), stream_filter_stage<F>{ fit::move(f) }));
+};
+
+struct stream_take_f
+{
+    template<class Range, FIT_STREAM_REQUIRE_SOURCE(Range)>
+    auto operator()(Range&& r, std::size_t n) const FIT_RETURNS
+    (detail::make_stream_pipeline(FIT_FORWARD(Range)(r), stream_take_stage{ n }));
+};
+
+struct stream_flat_map_f
+{
+    template<class Range, class F, FIT_STREAM_REQUIRE_SOURCE(Range)>
+    auto operator()(Range&& r, F f) const FIT_RETURNS
+    (detail::make_stream_pipeline(FIT_FORWARD(Range)(r), stream_flat_map_stage<F>{ fit::move(f) }));
+};
+
+struct stream_fold_f
+{
+    template<class Range, class F, class State, FIT_STREAM_REQUIRE_SOURCE(Range)>
+    State operator()(Range&& r, F f, State init) const
+    {
+        callable_base<F> g(fit::move(f));
+        stream_fold_sink<callable_base<F>, State> sink = { g, fit::move(init) };
+        detail::stream_run(r, sink);
+        return fit::move(sink.state);
+    }
+};
+
+struct stream_for_each_f
+{
+    template<class Range, class F, FIT_STREAM_REQUIRE_SOURCE(Range)>
+    void operator()(Range&& r, F f) const
+    {
+        callable_base<F> g(fit::move(f));
+        stream_for_each_sink<callable_base<F>> sink = { g };
+        detail::stream_run(r, sink);
+    }
+};
+
+#undef FIT_STREAM_REQUIRE_SOURCE
+
+}
+
+namespace stream {
+
+FIT_DECLARE_STATIC_VAR(map, pipable_adaptor<detail::stream_map_f>);
+FIT_DECLARE_STATIC_VAR(filter, pipable_adaptor<detail::stream_filter_f>);
+FIT_DECLARE_STATIC_VAR(take, pipable_adaptor<detail::stream_take_f>);
+FIT_DECLARE_STATIC_VAR(flat_map, pipable_adaptor<detail::stream_flat_map_f>);
+FIT_DECLARE_STATIC_VAR(fold, pipable_adaptor<detail::stream_fold_f>);
+FIT_DECLARE_STATIC_VAR(for_each, pipable_adaptor<detail::stream_for_each_f>);
+
+}
+
+} // namespace fit
+
+#endif
@@ -0,0 +1,486 @@
+/*=============================================================================
+    Copyright (c) 2016 Paul Fultz II
+    string_switch.h
+    Distributed under the Boost Software License, Version 1.0. (See accompanying
+    file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+==============================================================================*/
+
+#ifndef FIT_GUARD_FUNCTION_STRING_SWITCH_H
+#define FIT_GUARD_FUNCTION_STRING_SWITCH_H
+
+/// string_switch
+/// =============
+///
+/// Description
+/// -----------
+///
+/// The `string_switch` function adaptor dispatches on a runtime string. It
+/// takes pairs of keys and functions, and an optional fallback function at
+/// the end. When called with a name and arguments, the function whose key
+/// is equal to the name is called with the arguments. If no key matches,
+/// the fallback is called with the name and the arguments. Without a
+/// fallback, a default constructed result is returned instead.
+///
+/// A perfect hash over the keys is built when the adaptor is constructed,
+/// which happens at compile-time when the adaptor is initialized as a
+/// `constexpr` variable(this requires relaxed constexpr). Each call then
+/// computes one hash, does one string comparison, and one indirect call.
+///
+/// Just like `conditional`, if the same key is given more than once, the
+/// first one is used. If a function can't be called with the arguments,
+/// the fallback is used instead. The result type is the common type of all
+/// the functions that can be called.
+///
+/// Synopsis
+/// --------
+///
+///     template<class... Ts>
+///     constexpr auto string_switch(const char * key1, F1 f1, ..., const char * keyN, FN fN);
+///
+///     template<class... Ts>
+///     constexpr auto string_switch(const char * key1, F1 f1, ..., const char * keyN, FN fN, Fallback fallback);
+///
+/// Semantics
+/// ---------
+///
+///     assert(string_switch(k1, f1, k2, f2, g)(k2, xs...) == f2(xs...));
+///     assert(string_switch(k1, f1, k2, f2, g)(name, xs...) == g(name, xs...));
+///
+/// Requirements
+/// ------------
+///
+/// The name must be a `const char*` or have `data()` and `size()` member
+/// functions, such as `std::string`.
+///
+/// Fs must be:
+///
+/// * [ConstCallable](ConstCallable)
+/// * MoveConstructible
+///
+/// Example
+/// -------
+///
+///     #include <fit.hpp>
+///     #include <cassert>
+///     #include <string>
+///
+///     struct get_f
+///     {
+///         int operator()(int x) const
+///         {
+///             return x;
+///         }
+///     };
+///
+///     struct put_f
+///     {
+///         int operator()(int x) const
+///         {
+///             return x + 1;
+///         }
+///     };
+///
+///     struct unknown_f
+///     {
+///         int operator()(const std::string&, int) const
+///         {
+///             return -1;
+///         }
+///     };
+///
+///     int main() {
+///         auto command = fit::string_switch("get", get_f(), "put", put_f(), unknown_f());
+///         assert(command(std::string("get"), 1) == 1);
+///         assert(command(std::string("put"), 1) == 2);
+///         assert(command(std::string("del"), 1) == -1);
+///     }
+///
+
+#include <fit/is_callable.hpp>
+#include <fit/returns.hpp>
+#include <fit/detail/callable_base.hpp>
+#include <fit/detail/relaxed_constexpr.hpp>
+#include <fit/detail/seq.hpp>
+#include <fit/detail/static_const_var.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+
+namespace fit { namespace detail {
+
+inline FIT_RELAXED_CONSTEXPR std::size_t string_switch_strlen(const char * s)
+{
+    std::size_t n = 0;
+    while (s[n] != 0) n++;
+    return n;
+}
+
+inline FIT_RELAXED_CONSTEXPR bool string_switch_equal(const char * x, const char * y, std::size_t n)
+{
+    for(std::size_t i=0;i<n;i++) if (x[i] != y[i]) return false;
+    return true;
+}
+
+inline FIT_RELAXED_CONSTEXPR std::uint64_t string_switch_hash(const char * s, std::size_t n, std::uint64_t seed)
+{
+    // FNV-1a followed by a final mix so the high and low bits can be used
+    // independently
+    std::uint64_t h = 14695981039346656037ull ^ (seed * 0x9E3779B97F4A7C15ull);
+    for(std::size_t i=0;i<n;i++) h = (h ^ static_cast<unsigned char>(s[i])) * 1099511628211ull;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdull;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ull;
+    h ^= h >> 33;
+    return h;
+}
+
+constexpr std::size_t string_switch_pow2(std::size_t n, std::size_t r=1)
+{
+    return r >= n ? r : string_switch_pow2(n, r*2);
+}
+
+// A perfect hash table built with hash and displace. Keys are grouped into
+// buckets by the high bits of the hash, and each bucket has a displacement
+// that places all of its keys into free slots.
+template<std::size_t N>
+struct string_switch_table
+{
+    static_assert(N > 0, "No keys given to string_switch");
+    static_assert(N < 0xFFFF, "Too many keys given to string_switch");
+
+    static constexpr std::size_t table_size = string_switch_pow2(2*N);
+    static constexpr std::size_t bucket_count = N/2 + 1;
+    static constexpr std::size_t max_displacement = 4*table_size;
+    static constexpr unsigned short empty = 0xFFFF;
+
+    const char * keys[N];
+    std::size_t lengths[N];
+    std::uint64_t seed;
+    unsigned short displacements[bucket_count];
+    unsigned short slots[table_size];
+
+    template<class... Ks>
+    FIT_RELAXED_CONSTEXPR string_switch_table(Ks... ks)
+    : keys{ks...}, lengths{}, seed(0), displacements{}, slots{}
+    {
+        for(std::size_t i=0;i<N;i++) lengths[i] = string_switch_strlen(keys[i]);
+        while (!this->try_build()) seed++;
+    }
+
+    static constexpr std::size_t bucket(std::uint64_t h)
+    {
+        return static_cast<std::size_t>((h >> 32) % bucket_count);
+    }
+
+    static constexpr std::size_t position(std::uint64_t h, std::size_t d)
+    {
+        return static_cast<std::size_t>((h + d * ((h >> 17) | 1)) & (table_size - 1));
+    }
+
+    FIT_RELAXED_CONSTEXPR bool try_build()
+    {
+        std::uint64_t hashes[N] = {};
+        std::size_t counts[bucket_count] = {};
+        std::size_t offsets[bucket_count+1] = {};
+        std::size_t filled[bucket_count] = {};
+        std::size_t order[N] = {};
+        bool done[bucket_count] = {};
+
+        for(std::size_t i=0;i<table_size;i++) slots[i] = empty;
+        for(std::size_t i=0;i<N;i++)
+        {
+            hashes[i] = string_switch_hash(keys[i], lengths[i], seed);
+            counts[bucket(hashes[i])]++;
+        }
+        for(std::size_t b=0;b<bucket_count;b++) offsets[b+1] = offsets[b] + counts[b];
+        for(std::size_t i=0;i<N;i++)
+        {
+            std::size_t b = bucket(hashes[i]);
+            order[offsets[b] + filled[b]++] = i;
+        }
+        // Place the largest buckets first
+        for(std::size_t k=0;k<bucket_count;k++)
+        {
+            std::size_t b = bucket_count;
+            for(std::size_t j=0;j<bucket_count;j++)
+            {
+                if (!done[j] && (b == bucket_count || counts[j] > counts[b])) b = j;
+            }
+            done[b] = true;
+            if (counts[b] == 0) break;
+            bool placed = false;
+            for(std::size_t d=0;d<max_displacement && !placed;d++)
+            {
+                placed = true;
+                for(std::size_t x=offsets[b];x<offsets[b+1] && placed;x++)
+                {
+                    if (this->is_duplicate(order, offsets[b], x)) continue;
+                    std::size_t pos = position(hashes[order[x]], d);
+                    if (slots[pos] != empty) placed = false;
+                    else slots[pos] = static_cast<unsigned short>(order[x]);
+                }
+                if (placed) displacements[b] = static_cast<unsigned short>(d);
+                else for(std::size_t x=offsets[b];x<offsets[b+1];x++)
+                {
+                    std::size_t pos = position(hashes[order[x]], d);
+                    if (slots[pos] == order[x]) slots[pos] = empty;
+                }
+            }
+            if (!placed) return false;
+        }
+        return true;
+    }
+
+    // Equal keys always end up in the same bucket, and only the first one is
+    // placed
+    FIT_RELAXED_CONSTEXPR bool is_duplicate(const std::size_t * order, std::size_t first, std::size_t x) const
+    {
+        std::size_t i = order[x];
+        for(std::size_t y=first;y<x;y++)
+        {
+            std::size_t j = order[y];
+            if (lengths[i] == lengths[j] && string_switch_equal(keys[i], keys[j], lengths[i])) return true;
+        }
+        return false;
+    }
+
+    // Returns the index of the key, or N if there is none
+    FIT_RELAXED_CONSTEXPR std::size_t find(const char * s, std::size_t n) const
+    {
+        std::uint64_t h = string_switch_hash(s, n, seed);
+        std::size_t i = slots[position(h, displacements[bucket(h)])];
+        if (i != empty && lengths[i] == n && string_switch_equal(keys[i], s, n)) return i;
+        return N;
+    }
+};
+
+inline FIT_RELAXED_CONSTEXPR const char * string_switch_data(const char * s)
+{
+    return s;
+}
+
+inline FIT_RELAXED_CONSTEXPR std::size_t string_switch_size(const char * s)
+{
+    return string_switch_strlen(s);
+}
+
+template<class S>
+constexpr auto string_switch_data(const S& s) FIT_RETURNS(s.data());
+
+template<class S>
+constexpr auto string_switch_size(const S& s) FIT_RETURNS(s.size());
+
+struct string_switch_none
+{};
+
+// Used when no fallback is given
+struct string_switch_miss
+{};
+
+template<class T>
+struct string_switch_type
+{
+    typedef T type;
+};
+
+template<class F, class... Ts>
+struct string_switch_invoke
+: string_switch_type<decltype(std::declval<F>()(std::declval<Ts>()...))>
+{};
+
+template<class F, class... Ts>
+struct string_switch_result_of
+: std::conditional<is_callable<F, Ts...>::value,
+    string_switch_invoke<F, Ts...>,
+    string_switch_type<string_switch_none>
+>::type
+{};
+
+template<class... Ts>
+struct string_switch_result_of<const callable_base<string_switch_miss>&, Ts...>
+: string_switch_type<string_switch_none>
+{};
+
+template<class R1, class R2>
+struct string_switch_combine
+: std::common_type<R1, R2>
+{};
+
+template<class R>
+struct string_switch_combine<R, string_switch_none>
+: string_switch_type<R>
+{};
+
+template<class R>
+struct string_switch_combine<string_switch_none, R>
+: string_switch_type<R>
+{};
+
+template<>
+struct string_switch_combine<string_switch_none, string_switch_none>
+: string_switch_type<string_switch_none>
+{};
+
+template<class... Rs>
+struct string_switch_common;
+
+template<class R>
+struct string_switch_common<R>
+: string_switch_type<R>
+{};
+
+template<class R1, class R2, class... Rs>
+struct string_switch_common<R1, R2, Rs...>
+: string_switch_common<typename string_switch_combine<R1, R2>::type, Rs...>
+{};
+
+template<class R, class S, class... Ts>
+R string_switch_fallback(const callable_base<string_switch_miss>&, const S&, Ts&&...)
+{
+    return R();
+}
+
+template<class R, class Fallback, class S, class... Ts>
+R string_switch_fallback(const Fallback& f, const S& name, Ts&&... xs)
+{
+    return static_cast<R>(f(name, FIT_FORWARD(Ts)(xs)...));
+}
+
+template<class Fallback, class... Fs>
+struct string_switch_adaptor
+{
+    typedef string_switch_table<sizeof...(Fs)> table_type;
+    table_type table;
+    std::tuple<callable_base<Fs>...> fs;
+    callable_base<Fallback> fallback;
+
+    template<class X, class... Xs>
+    constexpr string_switch_adaptor(X&& f, const table_type& t, Xs&&... xs)
+    : table(t), fs(FIT_FORWARD(Xs)(xs)...), fallback(FIT_FORWARD(X)(f))
+    {}
+
+    template<class S, class... Ts>
+    struct result
+    : string_switch_common<
+        typename string_switch_result_of<const callable_base<Fs>&, Ts...>::type...,
+        typename string_switch_result_of<const callable_base<Fallback>&, const S&, Ts...>::type
+    >
+    {};
+
+    template<std::size_t I, class R, class S, class... Ts, typename std::enable_if<(
+        is_callable<const typename std::tuple_element<I, std::tuple<callable_base<Fs>...>>::type&, Ts...>::value
+    ), int>::type = 0>
+    static R call(const string_switch_adaptor& self, const S&, Ts&&... xs)
+    {
+        return static_cast<R>(std::get<I>(self.fs)(FIT_FORWARD(Ts)(xs)...));
+    }
+
+    template<std::size_t I, class R, class S, class... Ts, typename std::enable_if<(
+        !is_callable<const typename std::tuple_element<I, std::tuple<callable_base<Fs>...>>::type&, Ts...>::value
+    ), int>::type = 0>
+    static R call(const string_switch_adaptor& self, const S& name, Ts&&... xs)
+    {
+        return string_switch_fallback<R>(self.fallback, name, FIT_FORWARD(Ts)(xs)...);
+    }
+
+    template<class R, class S, class... Ts>
+    static R call_fallback(const string_switch_adaptor& self, const S& name, Ts&&... xs)
+    {
+        return string_switch_fallback<R>(self.fallback, name, FIT_FORWARD(Ts)(xs)...);
+    }
+
+    template<class R, std::size_t... Ns, class S, class... Ts>
+    R dispatch(seq<Ns...>, const S& name, Ts&&... xs) const
+    {
+        typedef R (*function_pointer)(const string_switch_adaptor&, const S&, Ts&&...);
+        static const function_pointer functions[] = {
+            &string_switch_adaptor::call<Ns, R, S, Ts...>...,
+            &string_switch_adaptor::call_fallback<R, S, Ts...>
+        };
+        return functions[this->index(name)](*this, name, FIT_FORWARD(Ts)(xs)...);
+    }
+
+    // Returns the index of the key that matches the name, or the number of
+    // keys if there is no match
+    template<class S>
+    FIT_RELAXED_CONSTEXPR std::size_t index(const S& name) const
+    {
+        return table.find(string_switch_data(name), string_switch_size(name));
+    }
+
+    template<class S, class... Ts, class R=typename result<S, Ts&&...>::type, class=typename std::enable_if<(
+        !std::is_same<R, string_switch_none>::value
+    )>::type>
+    R operator()(const S& name, Ts&&... xs) const
+    {
+        return this->dispatch<R>(typename gens<sizeof...(Fs)>::type(), name, FIT_FORWARD(Ts)(xs)...);
+    }
+};
+
+template<class Seq, class Tuple>
+struct string_switch_functions;
+
+template<std::size_t... Ns, class Tuple>
+struct string_switch_functions<seq<Ns...>, Tuple>
+{
+    template<class Fallback>
+    struct apply
+    {
+        typedef string_switch_adaptor<Fallback, typename std::decay<typename std::tuple_element<2*Ns+1, Tuple>::type>::type...> type;
+    };
+};
+
+template<class Seq, class Tuple>
+struct string_switch_builder;
+
+template<std::size_t... Ns, class Tuple>
+struct string_switch_builder<seq<Ns...>, Tuple>
+{
+    template<class Fallback>
+    static constexpr typename string_switch_functions<seq<Ns...>, Tuple>::template apply<Fallback>::type
+    call(Tuple&& t, Fallback&& f)
+    {
+        return typename string_switch_functions<seq<Ns...>, Tuple>::template apply<Fallback>::type(
+            FIT_FORWARD(Fallback)(f),
+            string_switch_table<sizeof...(Ns)>(static_cast<const char*>(std::get<2*Ns>(t))...),
+            std::get<2*Ns+1>(FIT_FORWARD(Tuple)(t))...
+        );
+    }
+};
+
+template<class Tuple>
+constexpr auto make_string_switch(std::false_type, Tuple&& t) FIT_RETURNS
+(
+    string_switch_builder<typename gens<std::tuple_size<Tuple>::value/2>::type, Tuple>::call(
+        FIT_FORWARD(Tuple)(t), string_switch_miss()
+    )
+);
+
+template<class Tuple>
+constexpr auto make_string_switch(std::true_type, Tuple&& t) FIT_RETURNS
+(
+    string_switch_builder<typename gens<std::tuple_size<Tuple>::value/2>::type, Tuple>::call(
+        FIT_FORWARD(Tuple)(t), typename std::decay<typename std::tuple_element<std::tuple_size<Tuple>::value-1, Tuple>::type>::type(
+            std::get<std::tuple_size<Tuple>::value-1>(FIT_FORWARD(Tuple)(t))
+        )
+    )
+);
+
+struct string_switch_f
+{
+    template<class... Ts>
+    constexpr auto operator()(Ts&&... xs) const FIT_RETURNS
+    (
+        make_string_switch(std::integral_constant<bool, (sizeof...(Ts) % 2 == 1)>(), std::tuple<Ts&&...>(FIT_FORWARD(Ts)(xs)...))
+    );
+};
+
+}
+
+FIT_DECLARE_STATIC_VAR(string_switch, detail::string_switch_f);
+
+} // namespace fit
+
+#endif
@@ -1,5 +1,6 @@
 #include <fit/always.hpp>
 #include <memory>
+#include <string>
 #include "test.hpp"
 
 FIT_TEST_CASE()
@@ -22,3 +23,67 @@ FIT_TEST_CASE()
     FIT_TEST_CHECK( fit::always_ref(i)(1,2,3,4,5) == 10 );
     FIT_TEST_CHECK( &fit::always_ref(i)(1,2,3,4,5) == &i );
 }
+
+namespace always_test {
+
+struct copy_counter
+{
+    int* copies;
+    int* moves;
+    long data[4];
+    copy_counter(int* c, int* m) : copies(c), moves(m), data()
+    {}
+    copy_counter(const copy_counter& rhs) : copies(rhs.copies), moves(rhs.moves), data()
+    {
+        ++*copies;
+    }
+    copy_counter(copy_counter&& rhs) : copies(rhs.copies), moves(rhs.moves), data()
+    {
+        ++*moves;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    int moves = 0;
+    auto f = fit::always(always_test::copy_counter(&copies, &moves));
+    FIT_TEST_CHECK(copies == 0);
+    const always_test::copy_counter& x = f(1, 2, 3);
+    f();
+    FIT_TEST_CHECK(copies == 0);
+    FIT_TEST_CHECK(&x == &f());
+    static_assert(std::is_same<decltype(f()), const always_test::copy_counter&>::value, "Not a reference");
+
+    int moves_before = moves;
+    always_test::copy_counter y = std::move(f)();
+    FIT_TEST_CHECK(copies == 0);
+    FIT_TEST_CHECK(moves > moves_before);
+    static_assert(std::is_same<decltype(std::move(f)()), always_test::copy_counter>::value, "Not a value");
+    (void)y;
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    int moves = 0;
+    auto f = fit::always_copy(always_test::copy_counter(&copies, &moves));
+    FIT_TEST_CHECK(copies == 0);
+    f(1, 2, 3);
+    f();
+    FIT_TEST_CHECK(copies == 2);
+    static_assert(std::is_same<decltype(f()), always_test::copy_counter>::value, "Not a value");
+}
+
+FIT_TEST_CASE()
+{
+    static_assert(std::is_same<decltype(fit::always(1)()), int>::value, "Not a value");
+    static_assert(std::is_same<decltype(fit::always(std::string())()), std::string>::value, "Not a value");
+    static const auto f = fit::always(std::string("hello"));
+    static_assert(std::is_same<decltype(f()), const std::string&>::value, "Not a reference");
+    FIT_TEST_CHECK(f() == "hello");
+    FIT_TEST_CHECK(fit::always(std::string("hello"))() == "hello");
+    FIT_TEST_CHECK(fit::always_copy(10)(1, 2) == 10);
+}
@@ -0,0 +1,226 @@
+#include <fit/and_then_flow.hpp>
+#include <string>
+#include "test.hpp"
+
+namespace and_then_flow_test {
+
+template<class T>
+struct optional
+{
+    bool engaged;
+    T value;
+
+    constexpr optional() : engaged(false), value()
+    {}
+
+    constexpr optional(T x) : engaged(true), value(x)
+    {}
+
+    constexpr explicit operator bool() const
+    {
+        return engaged;
+    }
+
+    constexpr const T& operator*() const
+    {
+        return value;
+    }
+};
+
+template<class E>
+struct unexpected
+{
+    E e;
+    constexpr explicit unexpected(E x) : e(x)
+    {}
+};
+
+template<class T, class E>
+struct expected
+{
+    typedef and_then_flow_test::unexpected<E> unexpected_type;
+    bool has_value;
+    T value;
+    E err;
+
+    constexpr expected(T x) : has_value(true), value(x), err()
+    {}
+
+    constexpr expected(unexpected_type u) : has_value(false), value(), err(u.e)
+    {}
+
+    constexpr explicit operator bool() const
+    {
+        return has_value;
+    }
+
+    constexpr const T& operator*() const
+    {
+        return value;
+    }
+
+    constexpr E error() const
+    {
+        return err;
+    }
+};
+
+struct positive
+{
+    constexpr optional<int> operator()(int x) const
+    {
+        return x > 0 ? optional<int>(x) : optional<int>();
+    }
+};
+
+struct halve
+{
+    constexpr optional<int> operator()(int x) const
+    {
+        return x % 2 == 0 ? optional<int>(x / 2) : optional<int>();
+    }
+};
+
+struct to_long
+{
+    constexpr optional<long> operator()(int x) const
+    {
+        return optional<long>(x + 1);
+    }
+};
+
+struct parse_digit
+{
+    constexpr expected<int, int> operator()(char c) const
+    {
+        return (c >= '0' && c <= '9') ? expected<int, int>(c - '0') : expected<int, int>(unexpected<int>(1));
+    }
+};
+
+struct nonzero
+{
+    constexpr expected<int, int> operator()(int x) const
+    {
+        return x != 0 ? expected<int, int>(x) : expected<int, int>(unexpected<int>(2));
+    }
+};
+
+struct reciprocal
+{
+    constexpr expected<double, int> operator()(int x) const
+    {
+        return expected<double, int>(1.0 / x);
+    }
+};
+
+struct widen
+{
+    constexpr expected<long, int> operator()(int x) const
+    {
+        return expected<long, int>(x);
+    }
+};
+
+struct counter
+{
+    int * count;
+    optional<int> operator()(int x) const
+    {
+        ++*count;
+        return optional<int>(x);
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace and_then_flow_test;
+    FIT_STATIC_TEST_CHECK(*fit::and_then_flow(positive())(3) == 3);
+    FIT_TEST_CHECK(*fit::and_then_flow(positive())(3) == 3);
+
+    FIT_STATIC_TEST_CHECK(*fit::and_then_flow(positive(), halve())(4) == 2);
+    FIT_TEST_CHECK(*fit::and_then_flow(positive(), halve())(4) == 2);
+    FIT_STATIC_TEST_CHECK(!fit::and_then_flow(positive(), halve())(-4));
+    FIT_TEST_CHECK(!fit::and_then_flow(positive(), halve())(-4));
+    FIT_STATIC_TEST_CHECK(!fit::and_then_flow(positive(), halve())(3));
+    FIT_TEST_CHECK(!fit::and_then_flow(positive(), halve())(3));
+
+    FIT_STATIC_TEST_CHECK(*fit::and_then_flow(positive(), halve(), halve())(8) == 2);
+    FIT_TEST_CHECK(*fit::and_then_flow(positive(), halve(), halve())(8) == 2);
+    FIT_TEST_CHECK(!fit::and_then_flow(positive(), halve(), halve())(6));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace and_then_flow_test;
+    auto f = fit::and_then_flow(positive(), halve(), to_long());
+    STATIC_ASSERT_SAME(decltype(f(4)), optional<long>);
+    FIT_TEST_CHECK(*f(4) == 3);
+    FIT_TEST_CHECK(!f(-4));
+    FIT_TEST_CHECK(!f(3));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace and_then_flow_test;
+    auto f = fit::and_then_flow(parse_digit(), nonzero(), reciprocal());
+    STATIC_ASSERT_SAME(decltype(f('2')), expected<double, int>);
+    FIT_TEST_CHECK(*f('2') == 0.5);
+    FIT_TEST_CHECK(!f('x'));
+    FIT_TEST_CHECK(f('x').error() == 1);
+    FIT_TEST_CHECK(!f('0'));
+    FIT_TEST_CHECK(f('0').error() == 2);
+
+    FIT_STATIC_TEST_CHECK(fit::and_then_flow(parse_digit(), nonzero())('0').error() == 2);
+    FIT_STATIC_TEST_CHECK(*fit::and_then_flow(parse_digit(), nonzero())('7') == 7);
+}
+
+namespace fit {
+
+// An empty optional has no error to convert
+template<>
+struct and_then_failure<and_then_flow_test::expected<long, int>>
+{
+    template<class X>
+    static constexpr and_then_flow_test::expected<long, int> apply(X&&)
+    {
+        return and_then_flow_test::expected<long, int>(and_then_flow_test::unexpected<int>(3));
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace and_then_flow_test;
+    // A default constructed expected is a success, so it's not used for failures
+    FIT_STATIC_TEST_CHECK(fit::detail::and_then_is_optional<optional<int>>::value);
+    FIT_STATIC_TEST_CHECK(fit::detail::and_then_is_optional<const int*>::value);
+    FIT_STATIC_TEST_CHECK(!fit::detail::and_then_is_optional<expected<long, int>>::value);
+    auto f = fit::and_then_flow(positive(), widen());
+    FIT_TEST_CHECK(*f(2) == 2);
+    FIT_TEST_CHECK(!f(-2));
+    FIT_TEST_CHECK(f(-2).error() == 3);
+    FIT_STATIC_TEST_CHECK(fit::and_then_flow(positive(), widen())(-2).error() == 3);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace and_then_flow_test;
+    int count = 0;
+    auto f = fit::and_then_flow(positive(), counter{&count}, counter{&count});
+    FIT_TEST_CHECK(!f(-1));
+    FIT_TEST_CHECK(count == 0);
+    FIT_TEST_CHECK(*f(1) == 1);
+    FIT_TEST_CHECK(count == 2);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace and_then_flow_test;
+    auto f = fit::and_then_flow([](const std::string& s) { return s.empty() ? optional<int>() : optional<int>(s[0] - '0'); }, halve());
+    FIT_TEST_CHECK(*f(std::string("4")) == 2);
+    FIT_TEST_CHECK(!f(std::string("")));
+    FIT_TEST_CHECK(!f(std::string("5")));
+}
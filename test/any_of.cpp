@@ -0,0 +1,103 @@
+#include <fit/any_of.hpp>
+#include <fit/by.hpp>
+#include <fit/unpack.hpp>
+#include <string>
+#include <tuple>
+#include "test.hpp"
+
+namespace any_of_test {
+
+struct is_negative
+{
+    template<class T>
+    constexpr bool operator()(T x) const
+    {
+        return x < 0;
+    }
+};
+
+// Counts how many times it is called
+struct counted_identity
+{
+    int * count;
+    template<class T>
+    T operator()(T x) const
+    {
+        ++*count;
+        return x;
+    }
+};
+
+struct is_string
+{
+    constexpr bool operator()(const std::string&) const
+    {
+        return true;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace any_of_test;
+    FIT_STATIC_TEST_CHECK(fit::any_of(is_negative())(1, -2.0, 3));
+    FIT_STATIC_TEST_CHECK(!fit::any_of(is_negative())(1, 2.0, 3));
+    FIT_STATIC_TEST_CHECK(!fit::any_of(is_negative())());
+    FIT_STATIC_TEST_CHECK(fit::all_of(is_negative())(-1, -2.0, -3));
+    FIT_STATIC_TEST_CHECK(!fit::all_of(is_negative())(-1, 2.0, -3));
+    FIT_STATIC_TEST_CHECK(fit::all_of(is_negative())());
+    FIT_STATIC_TEST_CHECK(fit::find_if(is_negative())(1, -2.0, 3) == 1);
+    FIT_STATIC_TEST_CHECK(fit::find_if(is_negative())(-1) == 0);
+    FIT_STATIC_TEST_CHECK(fit::find_if(is_negative())(1, 2.0, 3) == 3);
+    FIT_STATIC_TEST_CHECK(fit::find_if(is_negative())() == 0);
+
+    FIT_TEST_CHECK(fit::any_of(is_negative())(1, -2.0, 3));
+    FIT_TEST_CHECK(!fit::all_of(is_negative())(-1, 2.0, -3));
+    FIT_TEST_CHECK(fit::find_if(is_negative())(1, 2.0, -3) == 2);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace any_of_test;
+    // Sequences can be searched with unpack
+    FIT_TEST_CHECK(fit::unpack(fit::any_of(is_negative()))(std::make_tuple(1, -2.0, 3)));
+    FIT_TEST_CHECK(fit::unpack(fit::all_of(is_negative()))(std::make_tuple(-1, -2.0), std::make_tuple(-3)));
+    FIT_TEST_CHECK(fit::unpack(fit::find_if(is_negative()))(std::make_tuple(1, 2.0), std::make_tuple(3, -4)) == 3);
+    FIT_TEST_CHECK(fit::is_callable<decltype(fit::any_of(is_string())), std::string, const char*>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(fit::any_of(is_string())), std::string, int>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace any_of_test;
+    // The arguments after the result is known are not projected
+    int count = 0;
+    auto projection = counted_identity{&count};
+    FIT_TEST_CHECK(fit::by(projection, fit::any_of(is_negative()))(1, -2, 3, 4, 5));
+    FIT_TEST_CHECK(count == 2);
+
+    count = 0;
+    FIT_TEST_CHECK(!fit::by(projection, fit::all_of(is_negative()))(-1, -2, 3, -4, -5));
+    FIT_TEST_CHECK(count == 3);
+
+    count = 0;
+    FIT_TEST_CHECK(fit::by(projection, fit::find_if(is_negative()))(1, -2, 3) == 1);
+    FIT_TEST_CHECK(count == 2);
+
+    count = 0;
+    FIT_TEST_CHECK(fit::unpack(fit::by(projection, fit::any_of(is_negative())))(std::make_tuple(-1, 2, 3)));
+    FIT_TEST_CHECK(count == 1);
+
+    count = 0;
+    FIT_TEST_CHECK(!fit::by(projection, fit::any_of(is_negative()))(1, 2, 3));
+    FIT_TEST_CHECK(count == 3);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace any_of_test;
+    FIT_STATIC_TEST_CHECK(fit::by(fit::identity, fit::any_of(is_negative()))(1, -2, 3));
+    STATIC_ASSERT_EMPTY(fit::any_of(is_negative()));
+    STATIC_ASSERT_EMPTY(fit::by(fit::identity, fit::all_of(is_negative())));
+}
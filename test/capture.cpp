@@ -1,4 +1,5 @@
 #include <fit/capture.hpp>
+#include <fit/always.hpp>
 #include <fit/identity.hpp>
 #include "test.hpp"
 
@@ -68,3 +69,12 @@ FIT_TEST_CASE()
     f();
 }
 
+
+#if !((defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7) || defined(_MSC_VER))
+FIT_TEST_CASE()
+{
+    // The captured values are stored without padding between them
+    static_assert(sizeof(fit::capture('a', 1.5, 'b', 2.5)(binary_class())) <= 3*sizeof(double), "Capture is padded");
+    FIT_TEST_CHECK(fit::capture('a', 1.5, 'b', 2.5)(fit::always(true))());
+}
+#endif
@@ -0,0 +1,113 @@
+#include <fit/compress_until.hpp>
+#include <fit/compress.hpp>
+#include <fit/by.hpp>
+#include <fit/unpack.hpp>
+#include <string>
+#include <tuple>
+#include <utility>
+#include "test.hpp"
+
+namespace compress_until_test {
+
+struct not_zero
+{
+    constexpr bool operator()(int x) const
+    {
+        return x != 0;
+    }
+};
+
+struct compare_pair
+{
+    template<class T>
+    constexpr int operator()(int, const T& p) const
+    {
+        return p.first < p.second ? -1 : (p.second < p.first ? 1 : 0);
+    }
+};
+
+struct over
+{
+    int limit;
+    constexpr bool operator()(int x) const
+    {
+        return x > limit;
+    }
+};
+
+struct sum
+{
+    template<class T>
+    constexpr auto operator()(int x, T y) const FIT_RETURNS
+    (x + y);
+};
+
+struct counted_identity
+{
+    int * count;
+    template<class T>
+    T operator()(T x) const
+    {
+        ++*count;
+        return x;
+    }
+};
+
+struct append
+{
+    std::string operator()(std::string s, const std::string& x) const
+    {
+        return s + x;
+    }
+};
+
+struct long_enough
+{
+    bool operator()(const std::string& s) const
+    {
+        return s.size() >= 4;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace compress_until_test;
+    FIT_STATIC_TEST_CHECK(fit::compress_until(over{10}, sum(), 0)() == 0);
+    FIT_STATIC_TEST_CHECK(fit::compress_until(over{10}, sum(), 0)(1, 2, 3) == 6);
+    FIT_STATIC_TEST_CHECK(fit::compress_until(over{10}, sum(), 0)(5, 6, 7, 8) == 11);
+    FIT_STATIC_TEST_CHECK(fit::compress_until(over{10}, sum(), 11)(5, 6) == 11);
+    FIT_STATIC_TEST_CHECK(fit::compress_until(not_zero(), compare_pair(), 0)(std::make_pair(1, 1), std::make_pair(1, 2), std::make_pair(3, 0)) == -1);
+    FIT_STATIC_TEST_CHECK(fit::compress_until(not_zero(), compare_pair(), 0)(std::make_pair(1, 1), std::make_pair(2, 2)) == 0);
+
+    FIT_TEST_CHECK(fit::compress_until(over{10}, sum(), 0)(5, 6, 7, 8) == 11);
+    FIT_TEST_CHECK(fit::compress_until(long_enough(), append(), std::string())("ab", "cd", "ef") == "abcd");
+    FIT_TEST_CHECK(fit::compress_until(long_enough(), append(), std::string())("a", "b") == "ab");
+}
+
+FIT_TEST_CASE()
+{
+    using namespace compress_until_test;
+    // Without stopping it is the same as compress
+    FIT_TEST_CHECK(fit::compress_until(over{100}, sum(), 0)(1, 2, 3, 4) == fit::compress(sum(), 0)(1, 2, 3, 4));
+    FIT_TEST_CHECK(fit::unpack(fit::compress_until(over{3}, sum(), 0))(std::make_tuple(1, 2), std::make_tuple(3, 4)) == 6);
+    FIT_TEST_CHECK(fit::is_callable<decltype(fit::compress_until(over{3}, sum(), 0)), int, int>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(fit::compress_until(over{3}, sum(), 0)), int, std::string>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(fit::compress_until(long_enough(), append(), std::string())), int>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace compress_until_test;
+    // The arguments after the result is known are not projected
+    int count = 0;
+    auto f = fit::by(counted_identity{&count}, fit::compress_until(over{2}, sum(), 0));
+    FIT_TEST_CHECK(f(1, 2, 3, 4, 5) == 3);
+    FIT_TEST_CHECK(count == 2);
+
+    count = 0;
+    auto g = fit::by(counted_identity{&count}, fit::compress(sum(), 0));
+    FIT_TEST_CHECK(g(1, 2, 3, 4, 5) == 15);
+    FIT_TEST_CHECK(count == 5);
+}
@@ -4,9 +4,11 @@
 #include <fit/conditional.hpp>
 #include <fit/by.hpp>
 #include <fit/placeholders.hpp>
+#include <fit/unpack.hpp>
 
 #include <tuple>
 #include <type_traits>
+#include <list>
 #include <vector>
 
 template<class T>
@@ -194,3 +196,61 @@ FIT_TEST_CASE()
     FIT_TEST_CHECK(t == std::make_tuple(1, 4, 9));
 }
 
+
+struct copy_counter
+{
+    int * copies;
+    copy_counter(int * c) : copies(c)
+    {}
+    copy_counter(const copy_counter& rhs) : copies(rhs.copies)
+    {
+        ++*copies;
+    }
+    copy_counter(copy_counter&& rhs) : copies(rhs.copies)
+    {}
+    copy_counter& operator=(const copy_counter&) = default;
+    copy_counter& operator=(copy_counter&&) = default;
+};
+
+FIT_TEST_CASE()
+{
+    auto v = fit::construct<std::vector<int>>().from(1, 2, 3);
+    FIT_TEST_CHECK(v == std::vector<int>{1, 2, 3});
+    FIT_TEST_CHECK(v.capacity() >= 3);
+    auto empty = fit::construct<std::vector<int>>().from();
+    FIT_TEST_CHECK(empty.empty());
+    auto l = fit::construct<std::list<int>>().from(1, 2, 3);
+    FIT_TEST_CHECK(l == std::list<int>{1, 2, 3});
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    copy_counter a(&copies);
+    copy_counter b(&copies);
+    auto v = fit::construct<std::vector<copy_counter>>().from(std::move(a), std::move(b), copy_counter(&copies));
+    FIT_TEST_CHECK(v.size() == 3);
+    FIT_TEST_CHECK(copies == 0);
+    auto w = fit::construct<std::vector<copy_counter>>().from(a, b);
+    FIT_TEST_CHECK(w.size() == 2);
+    FIT_TEST_CHECK(copies == 2);
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    auto t = std::make_tuple(copy_counter(&copies), copy_counter(&copies), copy_counter(&copies));
+    copies = 0;
+    auto v = fit::unpack(fit::construct<std::vector<copy_counter>>().from)(std::move(t));
+    FIT_TEST_CHECK(v.size() == 3);
+    FIT_TEST_CHECK(copies == 0);
+}
+
+FIT_TEST_CASE()
+{
+    auto make = fit::construct<std::vector<int>>().from.by(fit::_1 * fit::_1);
+    FIT_TEST_CHECK(make(1, 2, 3) == std::vector<int>{1, 4, 9});
+    auto strings = fit::unpack(fit::construct<std::vector<std::string>>().from.by(fit::construct<std::string>()));
+    auto v = strings(std::make_tuple("a", "b"));
+    FIT_TEST_CHECK(v == std::vector<std::string>{"a", "b"});
+}
@@ -0,0 +1,131 @@
+#include <fit/contains.hpp>
+#include <array>
+#include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+namespace contains_test {
+
+struct tracked
+{
+    int value;
+    bool operator==(const tracked& rhs) const
+    {
+        return value == rhs.value;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    FIT_STATIC_TEST_CHECK(fit::contains(fit::value_set<1, 5, 9>(), 5));
+    FIT_STATIC_TEST_CHECK(!fit::contains(fit::value_set<1, 5, 9>(), 4));
+    FIT_STATIC_TEST_CHECK(!fit::contains(fit::value_set<1, 5, 9>(), -1));
+    FIT_STATIC_TEST_CHECK(!fit::contains(fit::value_set<1, 5, 9>(), 64));
+    FIT_STATIC_TEST_CHECK(!fit::contains(fit::value_set<1, 5, 9>(), 65));
+    FIT_STATIC_TEST_CHECK(fit::contains(fit::value_set<0, 63>(), 63u));
+    FIT_STATIC_TEST_CHECK(!fit::contains(fit::value_set<>(), 0));
+    // Values outside of a bitmask
+    FIT_STATIC_TEST_CHECK(fit::contains(fit::value_set<-1, 100, 1000>(), 1000));
+    FIT_STATIC_TEST_CHECK(fit::contains(fit::value_set<-1, 100, 1000>(), -1));
+    FIT_STATIC_TEST_CHECK(!fit::contains(fit::value_set<-1, 100, 1000>(), 101));
+    FIT_STATIC_TEST_CHECK(!fit::contains(fit::value_set<-1>(), static_cast<unsigned long long>(-1)));
+    FIT_STATIC_TEST_CHECK(fit::contains(fit::value_set<'a', 'e'>(), 'e'));
+    FIT_TEST_CHECK(5 <fit::in> fit::value_set<1, 5, 9>());
+    FIT_TEST_CHECK(!(6 <fit::in> fit::value_set<1, 5, 9>()));
+#if FIT_HAS_VARIABLE_TEMPLATES
+    FIT_TEST_CHECK(9 <fit::in> fit::set_c<1, 5, 9>);
+    FIT_STATIC_TEST_CHECK(fit::contains(fit::set_c<1, 5, 9>, 1));
+#endif
+}
+
+FIT_TEST_CASE()
+{
+    // Contiguous ranges
+    std::vector<int> v;
+    for(int i=0;i<100;i++) v.push_back(i*2);
+    FIT_TEST_CHECK(fit::contains(v, 0));
+    FIT_TEST_CHECK(fit::contains(v, 198));
+    FIT_TEST_CHECK(fit::contains(v, 64));
+    FIT_TEST_CHECK(!fit::contains(v, 3));
+    FIT_TEST_CHECK(!fit::contains(v, 200));
+    FIT_TEST_CHECK(fit::contains(v, 6LL));
+    FIT_TEST_CHECK(!fit::contains(v, (1LL << 32) + 6));
+    FIT_TEST_CHECK(!fit::contains(std::vector<int>(), 0));
+
+    std::vector<unsigned> u(20, 1);
+    u.back() = 4000000000u;
+    FIT_TEST_CHECK(fit::contains(u, 4000000000u));
+    FIT_TEST_CHECK(!fit::contains(u, -1));
+    FIT_TEST_CHECK(!fit::contains(u, static_cast<int>(4000000000u)));
+
+    int a[] = { 3, 1, 2 };
+    FIT_TEST_CHECK(1 <fit::in> a);
+    FIT_TEST_CHECK(!(4 <fit::in> a));
+
+    std::array<short, 3> s = {{ 1, 2, 3 }};
+    FIT_TEST_CHECK(3 <fit::in> s);
+    FIT_TEST_CHECK(!(3 + 65536 <fit::in> s));
+}
+
+FIT_TEST_CASE()
+{
+    // Bytes
+    std::vector<char> v = { 'a', 'b', '\xff' };
+    FIT_TEST_CHECK('b' <fit::in> v);
+    FIT_TEST_CHECK(!('c' <fit::in> v));
+    FIT_TEST_CHECK('\xff' <fit::in> v);
+    FIT_TEST_CHECK(!(300 <fit::in> v));
+    FIT_TEST_CHECK(!fit::contains(std::vector<char>(), 'a'));
+
+    std::vector<unsigned char> u = { 0, 200 };
+    FIT_TEST_CHECK(200 <fit::in> u);
+    FIT_TEST_CHECK(0 <fit::in> u);
+    FIT_TEST_CHECK(!(-56 <fit::in> u));
+
+    std::vector<signed char> sc = { -56 };
+    FIT_TEST_CHECK(-56 <fit::in> sc);
+    FIT_TEST_CHECK(!(200 <fit::in> sc));
+}
+
+FIT_TEST_CASE()
+{
+    // Member find
+    std::string s = "hello world";
+    FIT_TEST_CHECK("hello" <fit::in> s);
+    FIT_TEST_CHECK('w' <fit::in> s);
+    FIT_TEST_CHECK(!("foo" <fit::in> s));
+
+    std::set<int> set = { 1, 2, 3 };
+    FIT_TEST_CHECK(2 <fit::in> set);
+    FIT_TEST_CHECK(!(4 <fit::in> set));
+
+    std::map<int, std::string> m = { { 1, "1" }, { 4, "4" } };
+    FIT_TEST_CHECK(4 <fit::in> m);
+    FIT_TEST_CHECK(!(2 <fit::in> m));
+}
+
+FIT_TEST_CASE()
+{
+    // Sorted and other ranges
+    std::vector<int> v = { 1, 3, 5, 7 };
+    FIT_TEST_CHECK(5 <fit::in> fit::sorted(v));
+    FIT_TEST_CHECK(!(4 <fit::in> fit::sorted(v)));
+    FIT_TEST_CHECK(fit::contains(fit::sorted(std::vector<std::string>{ "a", "b" }), "b"));
+
+    std::list<int> l = { 1, 2 };
+    FIT_TEST_CHECK(2 <fit::in> l);
+    FIT_TEST_CHECK(!(3 <fit::in> l));
+
+    std::vector<contains_test::tracked> t = { { 1 }, { 2 } };
+    FIT_TEST_CHECK(fit::contains(t, contains_test::tracked{ 2 }));
+    FIT_TEST_CHECK(!fit::contains(t, contains_test::tracked{ 3 }));
+
+    std::vector<double> d = { 1.5, 2.5 };
+    FIT_TEST_CHECK(2.5 <fit::in> d);
+    FIT_TEST_CHECK(!(2 <fit::in> d));
+}
@@ -0,0 +1,126 @@
+#include <fit/cpu_dispatch.hpp>
+#include <memory>
+#include "test.hpp"
+
+namespace cpu_dispatch_test {
+
+struct always_feature
+{
+    static bool supported()
+    {
+        return true;
+    }
+};
+
+struct never_feature
+{
+    static bool supported()
+    {
+        return false;
+    }
+};
+
+template<int N>
+struct constant
+{
+    int operator()(int x) const
+    {
+        return N + x;
+    }
+};
+
+struct only_ints
+{
+    int operator()(int) const
+    {
+        return 1;
+    }
+};
+
+struct anything
+{
+    template<class T>
+    int operator()(T) const
+    {
+        return 2;
+    }
+};
+
+struct move_only
+{
+    std::unique_ptr<int> i;
+    move_only(int x) : i(new int(x))
+    {}
+    int operator()(int x) const
+    {
+        return *i + x;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace cpu_dispatch_test;
+    auto f = fit::cpu_dispatch(fit::cpu::avx512(constant<512>()), fit::cpu::avx2(constant<256>()), fit::cpu::sse42(constant<128>()), constant<0>());
+    int expected = fit::cpu::avx512_feature::supported() ? 512 :
+        fit::cpu::avx2_feature::supported() ? 256 :
+        fit::cpu::sse42_feature::supported() ? 128 : 0;
+    FIT_TEST_CHECK(f(1) == expected + 1);
+    FIT_TEST_CHECK(f(2) == expected + 2);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace cpu_dispatch_test;
+    // The scalar path is used when the features are missing
+    auto f = fit::cpu_dispatch(
+        fit::cpu_feature_adaptor<never_feature, constant<2>>(),
+        fit::cpu_feature_adaptor<never_feature, constant<1>>(),
+        constant<0>()
+    );
+    FIT_TEST_CHECK(f(1) == 1);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace cpu_dispatch_test;
+    // The first supported function is used
+    auto f = fit::cpu_dispatch(
+        fit::cpu_feature_adaptor<never_feature, constant<3>>(),
+        fit::cpu_feature_adaptor<always_feature, constant<2>>(),
+        fit::cpu_feature_adaptor<always_feature, constant<1>>(),
+        constant<0>()
+    );
+    FIT_TEST_CHECK(f(1) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace cpu_dispatch_test;
+    // Functions that can't be called are skipped
+    auto f = fit::cpu_dispatch(fit::cpu_feature_adaptor<always_feature, only_ints>(), anything());
+    FIT_TEST_CHECK(f(1) == 1);
+    FIT_TEST_CHECK(f("") == 2);
+    FIT_TEST_CHECK(fit::is_callable<decltype(f), int>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(fit::cpu_dispatch(only_ints())), const char*>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace cpu_dispatch_test;
+    auto f = fit::cpu_dispatch(fit::cpu::avx2(move_only(2)), move_only(1));
+    STATIC_ASSERT_MOVE_ONLY(decltype(f));
+    int expected = fit::cpu::avx2_feature::supported() ? 2 : 1;
+    FIT_TEST_CHECK(f(1) == expected + 1);
+    auto g = std::move(f);
+    FIT_TEST_CHECK(g(1) == expected + 1);
+}
+
+FIT_TEST_CASE()
+{
+    auto f = fit::cpu_dispatch(fit::cpu::sse42([](int x) { return x; }), [](int x) { return x; });
+    FIT_TEST_CHECK(f(3) == 3);
+    auto g = f;
+    FIT_TEST_CHECK(g(4) == 4);
+}
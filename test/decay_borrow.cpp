@@ -0,0 +1,131 @@
+// The checks are opt-in
+#define FIT_BORROW_CHECK 1
+#include <fit/decay_borrow.hpp>
+#include <fit/pack.hpp>
+#include <fit/capture.hpp>
+#include <fit/partial.hpp>
+#include <string>
+#include <vector>
+#include <array>
+#include "test.hpp"
+
+struct borrowed_data
+{
+    template<class T>
+    const void* operator()(const T& x) const
+    {
+        return x.data();
+    }
+};
+
+struct borrowed_size
+{
+    template<class T, class U>
+    std::size_t operator()(const T& x, const U& y) const
+    {
+        return x.size() + y.size();
+    }
+};
+
+FIT_TEST_CASE()
+{
+    std::string s = "hello";
+    auto view = fit::decay_borrow(s);
+    STATIC_ASSERT_SAME(decltype(view), fit::borrowed_string);
+    FIT_TEST_CHECK(view.data() == s.data());
+    FIT_TEST_CHECK(view.size() == s.size());
+    FIT_TEST_CHECK(view == "hello");
+    FIT_TEST_CHECK(view == s);
+    FIT_TEST_CHECK(view != "world");
+    FIT_TEST_CHECK(view.str() == s);
+    FIT_TEST_CHECK(view.valid());
+
+    const std::string& cs = s;
+    STATIC_ASSERT_SAME(decltype(fit::decay_borrow(cs)), fit::borrowed_string);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<int> v = {1, 2, 3};
+    auto view = fit::decay_borrow(v);
+    STATIC_ASSERT_SAME(decltype(view), fit::borrowed_span<int>);
+    FIT_TEST_CHECK(view.data() == v.data());
+    FIT_TEST_CHECK(view.size() == 3);
+    FIT_TEST_CHECK(view[1] == 2);
+    int sum = 0;
+    for(int x:view) sum += x;
+    FIT_TEST_CHECK(sum == 6);
+
+    std::array<int, 2> a = {{1, 2}};
+    STATIC_ASSERT_SAME(decltype(fit::decay_borrow(a)), fit::borrowed_span<int>);
+    FIT_TEST_CHECK(fit::decay_borrow(a).data() == a.data());
+}
+
+FIT_TEST_CASE()
+{
+    // Everything else is decayed
+    STATIC_ASSERT_SAME(decltype(fit::decay_borrow(std::string("hello"))), std::string);
+    STATIC_ASSERT_SAME(decltype(fit::decay_borrow(std::vector<int>())), std::vector<int>);
+    std::vector<bool> vb;
+    STATIC_ASSERT_SAME(decltype(fit::decay_borrow(vb)), std::vector<bool>);
+    int i = 1;
+    STATIC_ASSERT_SAME(decltype(fit::decay_borrow(i)), int);
+    STATIC_ASSERT_SAME(decltype(fit::decay_borrow(std::ref(i))), int&);
+    FIT_STATIC_TEST_CHECK(fit::decay_borrow(1) == 1);
+    FIT_TEST_CHECK(fit::decay_borrow(1) == 1);
+}
+
+FIT_TEST_CASE()
+{
+    std::string s = "hello";
+    FIT_TEST_CHECK(fit::pack_borrow(s)(borrowed_data()) == s.data());
+    FIT_TEST_CHECK(fit::pack_decay(s)(borrowed_data()) != s.data());
+
+    std::vector<int> v = {1, 2, 3};
+    FIT_TEST_CHECK(fit::pack_borrow(s, v)(borrowed_size()) == 8);
+
+    FIT_TEST_CHECK(fit::pack_borrow(1, 2)(binary_class()) == 3);
+    FIT_STATIC_TEST_CHECK(fit::pack_borrow(1, 2)(binary_class()) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    std::string s = "hello";
+    FIT_TEST_CHECK(fit::capture_borrow(s)(borrowed_data())() == s.data());
+    FIT_TEST_CHECK(fit::capture_decay(s)(borrowed_data())() != s.data());
+    FIT_TEST_CHECK(fit::capture_borrow(s)(borrowed_size())(std::string("abc")) == 8);
+
+    FIT_TEST_CHECK(fit::capture_borrow(1)(binary_class())(2) == 3);
+    FIT_STATIC_TEST_CHECK(fit::capture_borrow(1)(binary_class())(2) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    std::string s = "hello";
+    std::vector<int> v = {1, 2, 3};
+    auto f = fit::partial(borrowed_size())(fit::decay_borrow(s));
+    FIT_TEST_CHECK(f(fit::decay_borrow(v)) == 8);
+}
+
+#if FIT_BORROW_CHECK
+FIT_TEST_CASE()
+{
+    std::string s = "hello";
+    auto view = fit::decay_borrow(s);
+    FIT_TEST_CHECK(view.valid());
+    s[0] = 'j';
+    FIT_TEST_CHECK(!view.valid());
+}
+#endif
+
+#if FIT_BORROW_CHECK && FIT_HAS_ADDRESS_SANITIZER
+FIT_TEST_CASE()
+{
+    // A destroyed owner is found by the sanitizer, without reading freed memory
+    auto v = new std::vector<int>(100, 1);
+    auto view = fit::decay_borrow(*v);
+    FIT_TEST_CHECK(view.valid());
+    delete v;
+    FIT_TEST_CHECK(!view.valid());
+}
+#endif
@@ -0,0 +1,91 @@
+#include <fit/devirtualize.hpp>
+#include <fit/indirect.hpp>
+#include <memory>
+#include "test.hpp"
+
+namespace devirtualize_test {
+
+struct base
+{
+    virtual ~base() {}
+    virtual int operator()(int x) const = 0;
+};
+
+struct square final : base
+{
+    int operator()(int x) const override
+    {
+        return x*x;
+    }
+};
+
+struct twice final : base
+{
+    int operator()(int x) const override
+    {
+        return 2*x;
+    }
+};
+
+struct negate : base
+{
+    int operator()(int x) const override
+    {
+        return -x;
+    }
+};
+
+struct counter
+{
+    virtual ~counter() {}
+    virtual void operator()(int x) = 0;
+};
+
+struct sum_counter final : counter
+{
+    int total;
+    sum_counter() : total(0)
+    {}
+    void operator()(int x) override
+    {
+        total += x;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace devirtualize_test;
+    std::unique_ptr<base> s(new square());
+    std::unique_ptr<base> t(new twice());
+    std::unique_ptr<base> n(new negate());
+    FIT_TEST_CHECK(fit::devirtualize<square, twice>(s.get())(3) == 9);
+    FIT_TEST_CHECK(fit::devirtualize<square, twice>(t.get())(3) == 6);
+    FIT_TEST_CHECK(fit::devirtualize<twice, square>(s.get())(3) == 9);
+    // Falls back to the virtual call
+    FIT_TEST_CHECK(fit::devirtualize<square, twice>(n.get())(3) == -3);
+    FIT_TEST_CHECK(fit::devirtualize<>(n.get())(3) == -3);
+    FIT_TEST_CHECK(fit::devirtualize<square>(std::move(s))(4) == 16);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace devirtualize_test;
+    auto c = std::make_shared<sum_counter>();
+    std::shared_ptr<counter> p = c;
+    auto f = fit::devirtualize<sum_counter>(p);
+    f(2);
+    f(3);
+    FIT_TEST_CHECK(c->total == 5);
+    static_assert(std::is_same<decltype(f(1)), void>::value, "Not void");
+}
+
+FIT_TEST_CASE()
+{
+    using namespace devirtualize_test;
+    const base * b = new twice();
+    auto f = fit::devirtualize<square, twice>(b);
+    FIT_TEST_CHECK(f(5) == fit::indirect(b)(5));
+    delete b;
+}
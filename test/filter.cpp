@@ -1,4 +1,5 @@
 #include <fit/if.hpp>
+#include <fit/filter.hpp>
 #include "test.hpp"
 
 #include <fit/by.hpp>
@@ -7,6 +8,7 @@
 #include <fit/conditional.hpp>
 #include <fit/unpack.hpp>
 
+#include <memory>
 #include <tuple>
 
 #if (defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 8)
@@ -53,3 +55,67 @@ FIT_TEST_CASE()
 }
 
 
+
+struct unary_int
+{
+    constexpr int operator()(int x) const
+    {
+        return x;
+    }
+};
+
+struct count_args
+{
+    template<class... Ts>
+    constexpr int operator()(Ts&&...) const
+    {
+        return sizeof...(Ts);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::filter_c<std::is_integral>(make_tuple_f())(1, 2, 2.0, 3) == std::make_tuple(1, 2, 3));
+    FIT_TEST_CHECK(fit::filter_c<std::is_integral>(make_tuple_f())(1.0, 2.0) == std::make_tuple());
+    FIT_TEST_CHECK(fit::filter_c<std::is_integral>(make_tuple_f())() == std::make_tuple());
+    FIT_TEST_CHECK(fit::filter_c<std::is_floating_point>(make_tuple_f())(1, 2.0, '3', 4.0f) == std::make_tuple(2.0, 4.0f));
+    FIT_TEST_CHECK(fit::unpack_filter<std::is_integral>(make_tuple_f())(fit::pack(1, 2, 2.0, 3)) == std::make_tuple(1, 2, 3));
+    FIT_TEST_CHECK(fit::unpack_filter<std::is_integral>(make_tuple_f())(std::make_tuple(1, 2.0), std::make_tuple(3.0, 4)) == std::make_tuple(1, 4));
+#if FIT_HAS_CONSTEXPR_TUPLE
+    FIT_STATIC_TEST_CHECK(fit::unpack_filter<std::is_integral>(make_tuple_f())(fit::pack(1, 2, 2.0, 3)) == std::make_tuple(1, 2, 3));
+#endif
+    FIT_STATIC_TEST_CHECK(fit::filter_c<std::is_integral>(count_args())(1, 2.0, 3, 'x', 5.0f) == 3);
+    FIT_STATIC_TEST_CHECK(fit::filter_c<std::is_integral>(count_args())() == 0);
+}
+
+FIT_TEST_CASE()
+{
+    // The predicate sees the decayed type and the arguments keep their
+    // value category
+    int i = 1;
+    const int ci = 2;
+    auto f = fit::filter_c<std::is_integral>([](int& x, const int& y, int&& z)
+    {
+        x = y + z;
+        return x;
+    });
+    FIT_TEST_CHECK(f(i, 1.0, ci, "x", 3) == 5);
+    FIT_TEST_CHECK(i == 5);
+
+    auto g = fit::filter_c<std::is_class>([](std::unique_ptr<int> p)
+    {
+        return *p;
+    });
+    FIT_TEST_CHECK(g(1, std::unique_ptr<int>(new int(2)), 3) == 2);
+    FIT_TEST_CHECK(fit::filter_c<std::is_class>(fit::unpack(count_args()))(1, fit::pack(1, 2), 3) == 2);
+}
+
+FIT_TEST_CASE()
+{
+    // Functions that can't be called with the kept arguments are not callable
+    auto f = fit::filter_c<std::is_integral>(unary_int());
+    FIT_TEST_CHECK(f(1, 2.0) == 1);
+    FIT_TEST_CHECK(fit::is_callable<decltype(f), int, double>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(f), int, int>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(f), double>::value);
+}
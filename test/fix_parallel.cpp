@@ -0,0 +1,278 @@
+#include <fit/fix_parallel.hpp>
+#include <fit/fix.hpp>
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "test.hpp"
+
+namespace fix_parallel_test {
+
+struct fib
+{
+    template<class Self>
+    long operator()(Self self, int n) const
+    {
+        if (n < 2) return n;
+        auto r = self.fork(n - 1, n - 2);
+        return std::get<0>(r) + std::get<1>(r);
+    }
+};
+
+struct native_fib
+{
+    template<class Self>
+    long operator()(Self self, int n) const
+    {
+        if (n < 2) return n;
+        return self(n - 1) + self(n - 2);
+    }
+};
+
+struct small
+{
+    int size;
+    bool operator()(int n) const
+    {
+        return n < size;
+    }
+};
+
+struct range
+{
+    int * first;
+    int * last;
+};
+
+struct small_range
+{
+    bool operator()(range r) const
+    {
+        return r.last - r.first < 1000;
+    }
+};
+
+struct quicksort
+{
+    template<class Self>
+    int operator()(Self self, range r) const
+    {
+        if (r.last - r.first < 2) return 0;
+        int pivot = r.first[(r.last - r.first) / 2];
+        int * middle1 = std::partition(r.first, r.last, [=](int x) { return x < pivot; });
+        int * middle2 = std::partition(middle1, r.last, [=](int x) { return !(pivot < x); });
+        self.fork(range{ r.first, middle1 }, range{ middle2, r.last });
+        return 0;
+    }
+};
+
+struct node
+{
+    long value;
+    std::unique_ptr<node> left;
+    std::unique_ptr<node> right;
+
+    node(long v) : value(v)
+    {}
+};
+
+std::unique_ptr<node> balanced(long first, long last)
+{
+    if (first == last) return nullptr;
+    long mid = first + (last - first) / 2;
+    std::unique_ptr<node> n(new node(mid));
+    n->left = balanced(first, mid);
+    n->right = balanced(mid + 1, last);
+    return n;
+}
+
+struct sum_tree
+{
+    template<class Self>
+    long operator()(Self self, const node * n) const
+    {
+        if (n == nullptr) return 0;
+        auto r = self.fork(n->left.get(), n->right.get());
+        return std::get<0>(r) + n->value + std::get<1>(r);
+    }
+};
+
+struct native_sum_tree
+{
+    template<class Self>
+    long operator()(Self self, const node * n) const
+    {
+        if (n == nullptr) return 0;
+        return self(n->left.get()) + n->value + self(n->right.get());
+    }
+};
+
+// Forks three calls at once, and returns move-only results
+struct boxes
+{
+    template<class Self>
+    std::unique_ptr<int> operator()(Self self, int n) const
+    {
+        if (n < 3) return std::unique_ptr<int>(new int(n));
+        auto r = self.fork(n / 3, n / 3, n - 2 * (n / 3));
+        return std::unique_ptr<int>(new int(*std::get<0>(r) + *std::get<1>(r) + *std::get<2>(r)));
+    }
+};
+
+template<class Self>
+struct is_serial
+: std::false_type
+{};
+
+template<class F>
+struct is_serial<fit::fix_serial_self<F>>
+: std::true_type
+{};
+
+// Counts the calls that run with a serial self
+struct count_serial
+{
+    template<class Self>
+    int operator()(Self self, int n) const
+    {
+        if (n == 0) return is_serial<Self>::value;
+        auto r = self.fork(n - 1, n - 1);
+        return is_serial<Self>::value + std::get<0>(r) + std::get<1>(r);
+    }
+};
+
+// Counts the results that are alive
+struct counted
+{
+    static std::atomic<int> live;
+    long value;
+
+    counted(long v) : value(v)
+    {
+        ++live;
+    }
+
+    counted(const counted& c) : value(c.value)
+    {
+        ++live;
+    }
+
+    ~counted()
+    {
+        --live;
+    }
+};
+
+std::atomic<int> counted::live(0);
+
+// Throws when it's called with bad
+struct throwing_fib
+{
+    int bad;
+
+    template<class Self>
+    counted operator()(Self self, int n) const
+    {
+        if (n == bad) throw std::runtime_error("bad");
+        if (n < 2) return counted(n);
+        auto r = self.fork(n - 1, n - 2);
+        return counted(std::get<0>(r).value + std::get<1>(r).value);
+    }
+};
+
+template<class F>
+bool throws(F f)
+{
+    try
+    {
+        f();
+    }
+    catch(const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_parallel_test;
+    fit::fork_join_pool pool(4);
+    FIT_TEST_CHECK(pool.size() == 4);
+    long expected = fit::fix(native_fib())(22);
+    FIT_TEST_CHECK(fit::fix_parallel(fib(), 0, pool)(22) == expected);
+    FIT_TEST_CHECK(fit::fix_parallel(fib(), 5, pool)(22) == expected);
+    FIT_TEST_CHECK(fit::fix_parallel(fib(), 100, pool)(22) == expected);
+    FIT_TEST_CHECK(fit::fix_parallel(fib(), small{10}, pool)(22) == expected);
+    FIT_TEST_CHECK(fit::fix_parallel(fib(), small{0}, pool)(1) == 1);
+    FIT_TEST_CHECK(fit::fix_parallel(fib(), 3)(22) == expected);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_parallel_test;
+    fit::fork_join_pool pool(4);
+    std::vector<int> v(100000);
+    unsigned seed = 1;
+    for(auto&& x:v)
+    {
+        seed = seed * 1103515245u + 12345u;
+        x = int(seed >> 8) % 1000;
+    }
+    fit::fix_parallel(quicksort(), small_range(), pool)(range{ v.data(), v.data() + v.size() });
+    FIT_TEST_CHECK(std::is_sorted(v.begin(), v.end()));
+
+    std::unique_ptr<node> b = balanced(0, 10000);
+    FIT_TEST_CHECK(fit::fix_parallel(sum_tree(), 8, pool)(b.get()) == fit::fix(native_sum_tree())(b.get()));
+    FIT_TEST_CHECK(fit::fix_parallel(sum_tree(), 8, pool)(b.get()) == 10000L*9999L/2);
+
+    FIT_TEST_CHECK(*fit::fix_parallel(boxes(), 4, pool)(1000) == 1000);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_parallel_test;
+    fit::fork_join_pool pool(2);
+    // With a depth of 2, the calls at depth 2 and below are serial
+    FIT_TEST_CHECK(fit::fix_parallel(count_serial(), 2, pool)(4) == (1 << 5) - 1 - 3);
+    FIT_TEST_CHECK(fit::fix_parallel(count_serial(), 0, pool)(4) == (1 << 5) - 1);
+    FIT_TEST_CHECK(fit::fix_parallel(count_serial(), 10, pool)(4) == 0);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_parallel_test;
+    // Several threads can use the same pool at once
+    fit::fork_join_pool pool(3);
+    std::vector<long> results(4);
+    std::vector<std::thread> threads;
+    for(int i=0;i<4;i++) threads.emplace_back([&, i] {
+        results[i] = fit::fix_parallel(fib(), small{8}, pool)(18 + i);
+    });
+    for(auto&& t:threads) t.join();
+    for(int i=0;i<4;i++) FIT_TEST_CHECK(results[i] == fit::fix(native_fib())(18 + i));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_parallel_test;
+    // Exceptions reach the caller after the other calls of each fork finish
+    fit::fork_join_pool pool(4);
+    FIT_TEST_CHECK(fit::fix_parallel(throwing_fib{ -1 }, 100, pool)(15).value == 610);
+    // Thrown by the first call of a fork
+    FIT_TEST_CHECK(throws([&] { fit::fix_parallel(throwing_fib{ 1 }, 100, pool)(15); }));
+    // Thrown by the forked calls
+    FIT_TEST_CHECK(throws([&] { fit::fix_parallel(throwing_fib{ 0 }, 100, pool)(15); }));
+    FIT_TEST_CHECK(throws([&] { fit::fix_parallel(throwing_fib{ 13 }, 100, pool)(15); }));
+    // Thrown by the root call
+    FIT_TEST_CHECK(throws([&] { fit::fix_parallel(throwing_fib{ 15 }, 100, pool)(15); }));
+    // Thrown by serial calls
+    FIT_TEST_CHECK(throws([&] { fit::fix_parallel(throwing_fib{ 1 }, 3, pool)(15); }));
+    FIT_TEST_CHECK(counted::live == 0);
+    // The pool still works
+    FIT_TEST_CHECK(fit::fix_parallel(fib(), 100, pool)(15) == 610);
+}
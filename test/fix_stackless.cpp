@@ -0,0 +1,341 @@
+#include <fit/fix_stackless.hpp>
+#include <fit/fix.hpp>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+namespace fix_stackless_test {
+
+struct add_one
+{
+    long operator()(long x) const
+    {
+        return x + 1;
+    }
+};
+
+struct depth
+{
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, long n) const
+    {
+        if (n == 0) return 0;
+        return self(n - 1).then(add_one());
+    }
+};
+
+struct add
+{
+    long x;
+    long operator()(long y) const
+    {
+        return x + y;
+    }
+};
+
+struct ready_then
+{
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self, long n) const
+    {
+        return fit::stackless_frame<long>(n).then(add_one()).then(add{2});
+    }
+};
+
+struct fib
+{
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, int n) const
+    {
+        if (n < 2) return n;
+        return self(n - 1).then([=](long a) { return self(n - 2).then(add{a}); });
+    }
+};
+
+struct node
+{
+    long value;
+    std::unique_ptr<node> left;
+    std::unique_ptr<node> right;
+
+    node(long v) : value(v)
+    {}
+
+    // Avoid recursing when destroying a degenerate tree
+    ~node()
+    {
+        std::vector<std::unique_ptr<node>> pending;
+        if (left) pending.push_back(std::move(left));
+        if (right) pending.push_back(std::move(right));
+        while(!pending.empty())
+        {
+            std::unique_ptr<node> n = std::move(pending.back());
+            pending.pop_back();
+            if (n->left) pending.push_back(std::move(n->left));
+            if (n->right) pending.push_back(std::move(n->right));
+        }
+    }
+};
+
+std::unique_ptr<node> balanced(long first, long last)
+{
+    if (first == last) return nullptr;
+    long mid = first + (last - first) / 2;
+    std::unique_ptr<node> n(new node(mid));
+    n->left = balanced(first, mid);
+    n->right = balanced(mid + 1, last);
+    return n;
+}
+
+std::unique_ptr<node> chain(long n)
+{
+    std::unique_ptr<node> root;
+    for(long i=0;i<n;i++)
+    {
+        std::unique_ptr<node> r(new node(i));
+        r->left = std::move(root);
+        root = std::move(r);
+    }
+    return root;
+}
+
+struct sum_tree
+{
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, const node * n) const
+    {
+        if (n == nullptr) return 0;
+        return self(n->left.get()).then([=](long l) {
+            return self(n->right.get()).then(add{l + n->value});
+        });
+    }
+};
+
+struct native_sum_tree
+{
+    template<class Self>
+    long operator()(Self self, const node * n) const
+    {
+        if (n == nullptr) return 0;
+        return self(n->left.get()) + n->value + self(n->right.get());
+    }
+};
+
+struct append
+{
+    std::string s;
+    std::string operator()(std::string x) const
+    {
+        return x + s;
+    }
+};
+
+struct repeat_string
+{
+    template<class Self>
+    fit::stackless_frame<std::string> operator()(Self self, int n, const std::string& s) const
+    {
+        if (n == 0) return "";
+        return self(n - 1, s).then(append{s});
+    }
+};
+
+struct counted
+{
+    int * count;
+
+    counted(int * c) : count(c)
+    {
+        ++*count;
+    }
+
+    counted(const counted& rhs) : count(rhs.count)
+    {
+        ++*count;
+    }
+
+    ~counted()
+    {
+        --*count;
+    }
+
+    long operator()(long x) const
+    {
+        return x;
+    }
+};
+
+struct discard_frames
+{
+    int * live;
+
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, long n) const
+    {
+        if (n == 0) return 0;
+        {
+            // A frame that is dropped frees its continuations without running them
+            fit::stackless_frame<long> unused = self(n - 1).then(counted(live)).then(add_one());
+        }
+        return self(n - 1).then(add_one());
+    }
+};
+
+// Throws from a continuation when it is called with bad
+struct throw_at
+{
+    long bad;
+
+    long operator()(long x) const
+    {
+        if (x == bad) throw std::runtime_error("bad");
+        return x + 1;
+    }
+};
+
+// Throws from the call at the bottom, or from a continuation on the way up
+struct throwing_depth
+{
+    int * live;
+    long bad;
+
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, long n) const
+    {
+        if (n == 0)
+        {
+            if (bad < 0) throw std::runtime_error("bad");
+            return 0;
+        }
+        return self(n - 1).then(counted(live)).then(throw_at{bad});
+    }
+};
+
+template<class F>
+bool throws(F f)
+{
+    try
+    {
+        f();
+    }
+    catch(const std::runtime_error&)
+    {
+        return true;
+    }
+    return false;
+}
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_stackless_test;
+    FIT_TEST_CHECK(fit::fix_stackless<long>(depth())(0) == 0);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(depth())(10) == 10);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(fib())(20) == 6765);
+    FIT_TEST_CHECK(fit::fix_stackless<std::string>(repeat_string())(3, std::string("ab")) == "ababab");
+    // A continuation on a value runs at once
+    FIT_TEST_CHECK(fit::fix_stackless<long>(ready_then())(1) == 4);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_stackless_test;
+    // Much deeper than the stack allows
+    FIT_TEST_CHECK(fit::fix_stackless<long>(depth())(1000000) == 1000000);
+
+    std::unique_ptr<node> c = chain(1000000);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(sum_tree())(c.get()) == 1000000L*999999L/2);
+
+    std::unique_ptr<node> b = balanced(0, 1000);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(sum_tree())(b.get()) == fit::fix(native_sum_tree())(b.get()));
+    FIT_TEST_CHECK(fit::fix_stackless<long>(sum_tree())(b.get()) == 1000L*999L/2);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_stackless_test;
+    int live = 0;
+    FIT_TEST_CHECK(fit::fix_stackless<long>(discard_frames{&live})(10) == 10);
+    FIT_TEST_CHECK(live == 0);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_stackless_test;
+    // The pending continuations are freed when the recursion throws
+    int live = 0;
+    FIT_TEST_CHECK(throws([&] { fit::fix_stackless<long>(throwing_depth{&live, -1})(100); }));
+    FIT_TEST_CHECK(live == 0);
+    FIT_TEST_CHECK(throws([&] { fit::fix_stackless<long>(throwing_depth{&live, 50})(100); }));
+    FIT_TEST_CHECK(live == 0);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(throwing_depth{&live, 1000})(100) == 100);
+    FIT_TEST_CHECK(live == 0);
+}
+
+#if FIT_HAS_COROUTINES
+namespace fix_stackless_test {
+
+struct co_sum_tree
+{
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, const node * n) const
+    {
+        if (n == nullptr) co_return 0;
+        long l = co_await self(n->left.get());
+        long r = co_await self(n->right.get());
+        co_return l + n->value + r;
+    }
+};
+
+struct co_depth
+{
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, long n) const
+    {
+        if (n == 0) co_return 0;
+        // Continuations and values can be awaited as well
+        long x = co_await self(n - 1).then(add_one());
+        co_return x + co_await fit::stackless_frame<long>(0);
+    }
+};
+
+struct co_throwing_depth
+{
+    int * live;
+
+    template<class Self>
+    fit::stackless_frame<long> operator()(Self self, long n) const
+    {
+        if (n == 0) throw std::runtime_error("bad");
+        counted c(live);
+        co_return c(co_await self(n - 1)) + 1;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_stackless_test;
+    FIT_TEST_CHECK(fit::fix_stackless<long>(co_depth())(0) == 0);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(co_depth())(100000) == 100000);
+
+    std::unique_ptr<node> c = chain(100000);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(co_sum_tree())(c.get()) == 100000L*99999L/2);
+    std::unique_ptr<node> b = balanced(0, 1000);
+    FIT_TEST_CHECK(fit::fix_stackless<long>(co_sum_tree())(b.get()) == 1000L*999L/2);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace fix_stackless_test;
+    // An exception from a coroutine leaves the recursion, and the suspended
+    // coroutines are destroyed
+    int live = 0;
+    FIT_TEST_CHECK(throws([&] { fit::fix_stackless<long>(co_throwing_depth{&live})(100); }));
+    FIT_TEST_CHECK(live == 0);
+}
+#endif
@@ -0,0 +1,308 @@
+#include <fit/hash_fields.hpp>
+#include <fit/pack.hpp>
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <functional>
+#include <string>
+#if FIT_HAS_STRING_VIEW
+#include <string_view>
+#endif
+#include <tuple>
+#include <unordered_set>
+#include <vector>
+#include "test.hpp"
+
+namespace hash_fields_test {
+
+struct point
+{
+    int x;
+    int y;
+};
+
+// Has padding after c
+struct padded
+{
+    char c;
+    int i;
+};
+
+// A view without padding that holds a pointer, like std::string_view
+struct view
+{
+    const char * p;
+    std::size_t n;
+
+    const char * data() const
+    {
+        return p;
+    }
+
+    std::size_t size() const
+    {
+        return n;
+    }
+
+    const char * begin() const
+    {
+        return p;
+    }
+
+    const char * end() const
+    {
+        return p + n;
+    }
+};
+
+// Compares letters without case, so equal values can have different bytes
+struct ci
+{
+    unsigned char c;
+
+    bool operator==(const ci& rhs) const
+    {
+        return std::tolower(c) == std::tolower(rhs.c);
+    }
+};
+
+struct equal_only
+{
+    int i;
+
+    bool operator==(const equal_only& rhs) const
+    {
+        return i == rhs.i;
+    }
+};
+
+enum class color : short
+{
+    red,
+    green
+};
+
+struct combine_hash
+{
+    template<class... Ts>
+    std::size_t operator()(const std::tuple<Ts...>& t) const
+    {
+        return fit::unpack(fit::compress(*this, std::size_t(0)))(t);
+    }
+
+    // Same as boost::hash_combine
+    template<class T>
+    std::size_t operator()(std::size_t seed, const T& x) const
+    {
+        return seed ^ (std::hash<T>()(x) + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    }
+};
+
+struct grid_key
+{
+    std::tuple<int, int, int> operator()(int i, int j, int k) const
+    {
+        return std::make_tuple(i, j, k);
+    }
+};
+
+struct high_bits_key
+{
+    std::tuple<long long, long long, long long> operator()(int i, int j, int k) const
+    {
+        return std::make_tuple((long long)i << 32, (long long)j << 32, (long long)k << 32);
+    }
+};
+
+template<class Hash, class Key>
+std::size_t max_bucket_load(Hash h, Key key, std::size_t buckets)
+{
+    std::vector<std::size_t> load(buckets);
+    for(int i=0;i<32;i++)
+        for(int j=0;j<32;j++)
+            for(int k=0;k<32;k++)
+                load[h(key(i, j, k)) % buckets]++;
+    return *std::max_element(load.begin(), load.end());
+}
+
+template<class Hash, class Key>
+std::size_t distinct(Hash h, Key key)
+{
+    std::unordered_set<std::size_t> s;
+    for(int i=0;i<32;i++)
+        for(int j=0;j<32;j++)
+            for(int k=0;k<32;k++)
+                s.insert(h(key(i, j, k)));
+    return s.size();
+}
+
+}
+
+namespace std {
+
+template<>
+struct hash<hash_fields_test::ci>
+{
+    std::size_t operator()(const hash_fields_test::ci& x) const
+    {
+        return std::hash<int>()(std::tolower(x.c));
+    }
+};
+
+}
+
+namespace fit {
+
+template<>
+struct unpack_sequence<hash_fields_test::padded>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        f(s.c, s.i)
+    );
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(1, 2, 3)) == fit::hash_fields(std::make_tuple(1, 2, 3)));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(1, 2, 3)) != fit::hash_fields(std::make_tuple(3, 2, 1)));
+    FIT_TEST_CHECK(fit::hash_fields(fit::pack(1, 2)) == fit::hash_fields(fit::pack(1, 2)));
+    FIT_TEST_CHECK(fit::hash_fields(fit::pack(1, 2)) != fit::hash_fields(fit::pack(2, 1)));
+
+    std::string ab = "ab";
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(ab, 1)) == fit::hash_fields(std::make_tuple(std::string("ab"), 1)));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(std::string("ab"), std::string("c"))) !=
+        fit::hash_fields(std::make_tuple(std::string("a"), std::string("bc"))));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(std::string(100, 'x'), 1)) != fit::hash_fields(std::make_tuple(std::string(101, 'x'), 1)));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    // Both zeros compare equal
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(0.0, 1.0f)) == fit::hash_fields(std::make_tuple(-0.0, 1.0f)));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(0.5, 1.0f)) != fit::hash_fields(std::make_tuple(1.5, 1.0f)));
+    // Small fields are batched into the same word
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(short(1), true, color::green, 'a')) ==
+        fit::hash_fields(std::make_tuple(short(1), true, color::green, 'a')));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(short(1), true, color::green, 'a')) !=
+        fit::hash_fields(std::make_tuple(short(1), false, color::green, 'a')));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(short(-1), -1)) != fit::hash_fields(std::make_tuple(short(-1), 1)));
+    int i = 0;
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(&i, 1)) == fit::hash_fields(std::make_tuple(&i, 1)));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    // Nested sequences and empty fields
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(1, std::make_tuple(2, std::string("x")))) ==
+        fit::hash_fields(std::make_tuple(1, std::make_tuple(2, std::string("x")))));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(1, std::make_tuple(2, 3))) !=
+        fit::hash_fields(std::make_tuple(1, std::make_tuple(3, 2))));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(1, std::integral_constant<int, 5>(), 2)) ==
+        fit::hash_fields(std::make_tuple(1, 2)));
+
+    // Ranges
+    std::vector<std::string> words = { "a", "b" };
+    FIT_TEST_CHECK(fit::hash_fields(words) == fit::hash_fields(std::vector<std::string>({ "a", "b" })));
+    FIT_TEST_CHECK(fit::hash_fields(words) != fit::hash_fields(std::vector<std::string>({ "ab" })));
+    FIT_TEST_CHECK(fit::hash_fields(std::vector<int>({ 1, 2, 3 })) != fit::hash_fields(std::vector<int>({ 1, 2 })));
+    FIT_TEST_CHECK(fit::hash_fields(std::vector<float>({ 0.0f })) == fit::hash_fields(std::vector<float>({ -0.0f })));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    // Types with an unpack_sequence specialisation are hashed by their fields
+    padded a = { 'a', 1 };
+    padded b = { 'a', 1 };
+    FIT_TEST_CHECK(fit::hash_fields(a) == fit::hash_fields(b));
+    b.i = 2;
+    FIT_TEST_CHECK(fit::hash_fields(a) != fit::hash_fields(b));
+    FIT_TEST_CHECK(fit::hash_fields(a) == fit::hash_fields(std::make_tuple('a', 1)));
+}
+
+#if FIT_HAS_UNIQUE_OBJECT_REPRESENTATIONS
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    // Structs without padding are hashed from their bytes
+    point p = { 1, 2 };
+    point q = { 1, 2 };
+    FIT_TEST_CHECK(fit::hash_fields(p) == fit::hash_fields(q));
+    q.y = 3;
+    FIT_TEST_CHECK(fit::hash_fields(p) != fit::hash_fields(q));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(p, std::string("x"))) != fit::hash_fields(std::make_tuple(q, std::string("x"))));
+    FIT_TEST_CHECK(fit::is_callable<fit::field_hash, point>::value);
+
+    struct unknown
+    {
+        char c;
+        int i;
+    };
+    FIT_TEST_CHECK(!fit::is_callable<fit::field_hash, unknown>::value);
+    FIT_TEST_CHECK(!fit::is_callable<fit::field_hash, std::tuple<int, unknown>>::value);
+}
+#endif
+
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    // A type with its own std::hash and operator== isn't hashed from its bytes
+    FIT_STATIC_TEST_CHECK(!fit::detail::hash_is_bytes<ci>::value);
+    FIT_STATIC_TEST_CHECK(!fit::detail::hash_is_bytes<equal_only>::value);
+    ci upper = { 'A' };
+    ci lower = { 'a' };
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(upper)) == fit::hash_fields(std::make_tuple(lower)));
+    FIT_TEST_CHECK(fit::hash_fields(upper) == fit::hash_fields(lower));
+    FIT_TEST_CHECK(fit::hash_fields(std::vector<ci>{ upper, lower }) == fit::hash_fields(std::vector<ci>{ lower, upper }));
+    FIT_TEST_CHECK(!fit::is_callable<fit::field_hash, equal_only>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    // Equal views of different buffers have the same hash
+    std::string x = "abc";
+    std::string y = "abc";
+    view vx = { x.data(), x.size() };
+    view vy = { y.data(), y.size() };
+    FIT_STATIC_TEST_CHECK(!fit::detail::hash_is_bytes<view>::value);
+    FIT_TEST_CHECK(fit::hash_fields(vx) == fit::hash_fields(vy));
+    FIT_TEST_CHECK(fit::hash_fields(vx) == fit::hash_fields(x));
+    FIT_TEST_CHECK(fit::hash_fields(std::make_tuple(vx, 1)) == fit::hash_fields(std::make_tuple(vy, 1)));
+    FIT_TEST_CHECK(fit::hash_fields(std::vector<view>{ vx, vy }) == fit::hash_fields(std::vector<view>{ vy, vx }));
+    y[0] = 'x';
+    FIT_TEST_CHECK(fit::hash_fields(vx) != fit::hash_fields(vy));
+#if FIT_HAS_STRING_VIEW
+    FIT_TEST_CHECK(fit::hash_fields(std::string_view(x)) == fit::hash_fields(std::string_view(std::string("abc"))));
+#endif
+}
+
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    std::unordered_set<std::tuple<std::string, int>, fit::field_hash> s;
+    s.insert(std::make_tuple("a", 1));
+    s.insert(std::make_tuple("a", 2));
+    s.insert(std::make_tuple("a", 1));
+    FIT_TEST_CHECK(s.size() == 2);
+    FIT_TEST_CHECK(s.count(std::make_tuple("a", 2)) == 1);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace hash_fields_test;
+    // Keys that only differ in a few bits have no collisions, and spread
+    // over the buckets of a power of two table like random numbers would
+    FIT_TEST_CHECK(distinct(fit::hash_fields, grid_key()) == 32*32*32);
+    FIT_TEST_CHECK(distinct(fit::hash_fields, high_bits_key()) == 32*32*32);
+    FIT_TEST_CHECK(distinct(fit::hash_fields, grid_key()) >= distinct(combine_hash(), grid_key()));
+    FIT_TEST_CHECK(distinct(fit::hash_fields, high_bits_key()) >= distinct(combine_hash(), high_bits_key()));
+    FIT_TEST_CHECK(max_bucket_load(fit::hash_fields, grid_key(), 1 << 15) <= 12);
+    FIT_TEST_CHECK(max_bucket_load(fit::hash_fields, high_bits_key(), 1 << 15) <= 12);
+}
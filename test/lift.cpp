@@ -14,6 +14,9 @@ constexpr T sum(T x, U y)
 FIT_LIFT_CLASS(max_f, std::max);
 FIT_LIFT_CLASS(sum_f, sum);
 
+FIT_LIFT_NAMED(lifted_max, std::max);
+FIT_LIFT_NAMED(lifted_sum, sum);
+
 FIT_TEST_CASE()
 {
     FIT_TEST_CHECK(max_f()(3, 4) == std::max(3, 4));
@@ -22,6 +25,17 @@ FIT_TEST_CASE()
     FIT_STATIC_TEST_CHECK(sum_f()(1, 2) == 3);
 }
 
+FIT_TEST_CASE()
+{
+    FIT_TEST_CHECK(lifted_max(3, 4) == std::max(3, 4));
+    FIT_TEST_CHECK(lifted_sum(1, 2) == 3);
+    FIT_STATIC_TEST_CHECK(lifted_sum(1, 2) == 3);
+    STATIC_ASSERT_SAME(std::decay<decltype(lifted_max)>::type, fit_lifted_lifted_max);
+    auto f = lifted_max;
+    auto g = lifted_max;
+    STATIC_ASSERT_SAME(decltype(f), decltype(g));
+}
+
 #if FIT_HAS_GENERIC_LAMBDA
 FIT_TEST_CASE()
 {
@@ -0,0 +1,171 @@
+#include <fit/mapped_records.hpp>
+#include <fit/by.hpp>
+#include <fit/compress.hpp>
+#include <fit/unpack.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+namespace mapped_records_test {
+
+template<class T>
+void put(std::FILE * f, T x)
+{
+    std::fwrite(&x, sizeof(x), 1, f);
+}
+
+// Writes records of an int64, an int32, a short and two bytes of padding
+void write_file(const char * path, int n)
+{
+    std::FILE * f = std::fopen(path, "wb");
+    for(int i=0;i<n;i++)
+    {
+        put(f, std::int64_t(i) << 32);
+        put(f, std::int32_t(i));
+        put(f, std::int16_t(-i));
+        put(f, std::int16_t(0x7777));
+    }
+    std::fclose(f);
+}
+
+struct sum
+{
+    template<class T, class U>
+    std::int64_t operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+struct count_fields
+{
+    template<class... Ts>
+    int operator()(const Ts&...) const
+    {
+        return sizeof...(Ts);
+    }
+};
+
+struct address_of
+{
+    template<class T, class U, class V>
+    const void * operator()(const T& x, const U&, const V&) const
+    {
+        return &x;
+    }
+};
+
+struct second
+{
+    template<class T, class U, class V>
+    std::int32_t operator()(const T&, const U& y, const V&) const
+    {
+        return y;
+    }
+};
+
+struct less
+{
+    template<class T>
+    bool operator()(const T& x, const T& y) const
+    {
+        return x < y;
+    }
+};
+
+typedef fit::record_mapping<std::int64_t, std::int32_t, std::int16_t, fit::mapped_padding<2>> mapping;
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace mapped_records_test;
+    typedef fit::detail::mapped_layout<std::int64_t, std::int32_t, std::int16_t, fit::mapped_padding<2>> layout;
+    FIT_STATIC_TEST_CHECK(layout::size == 16);
+    FIT_STATIC_TEST_CHECK(layout::alignment == alignof(std::int64_t));
+    FIT_STATIC_TEST_CHECK(fit::detail::mapped_offset<2, std::int64_t, std::int32_t, std::int16_t>::value == 12);
+    FIT_STATIC_TEST_CHECK(!fit::detail::mapped_is_aligned<0, char, int>::value);
+    FIT_STATIC_TEST_CHECK(fit::detail::mapped_is_aligned<0, char, fit::mapped_padding<3>, int>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace mapped_records_test;
+    const char * path = "mapped_records_test.bin";
+    write_file(path, 100);
+    {
+        mapping m = fit::mapped_records<std::int64_t, std::int32_t, std::int16_t, fit::mapped_padding<2>>(path);
+        FIT_TEST_CHECK(m.ok());
+        FIT_TEST_CHECK(m.size() == 100);
+        FIT_TEST_CHECK(!m.empty());
+        FIT_TEST_CHECK(std::distance(m.begin(), m.end()) == 100);
+
+        // Iterators
+        mapping::iterator it = m.begin();
+        FIT_TEST_CHECK(it->get<1>() == 0);
+        FIT_TEST_CHECK((5 + it)->get<1>() == 5);
+        FIT_TEST_CHECK((it + 5)[2].get<1>() == 7);
+        FIT_TEST_CHECK(m.end() - it == 100);
+        FIT_TEST_CHECK(it < m.end());
+        FIT_TEST_CHECK(m.end() > it);
+        FIT_TEST_CHECK(it <= it);
+        FIT_TEST_CHECK(it >= it);
+        FIT_TEST_CHECK(!(it >= m.end()));
+        FIT_TEST_CHECK(!(m.end() <= it));
+
+        // Padding is not unpacked, and the fields refer into the mapping
+        FIT_TEST_CHECK(fit::unpack(count_fields())(m[7]) == 3);
+        FIT_TEST_CHECK(fit::unpack(address_of())(m[7]) == m[7].data());
+        FIT_TEST_CHECK(fit::unpack(second())(m[7]) == 7);
+        FIT_TEST_CHECK(m[7].get<2>() == -7);
+        FIT_TEST_CHECK(fit::unpack(fit::compress(sum(), std::int64_t(0)))(m[3]) == (std::int64_t(3) << 32) + 3 - 3);
+
+        std::int64_t total = 0;
+        for(auto&& r:m) total += fit::unpack(second())(r);
+        FIT_TEST_CHECK(total == 99*100/2);
+
+        // Sort the records by one of their fields
+        auto by_second = fit::by(fit::unpack(second()), less());
+        FIT_TEST_CHECK(by_second(m[2], m[3]));
+        FIT_TEST_CHECK(!by_second(m[3], m[2]));
+        FIT_TEST_CHECK(std::is_sorted(m.begin(), m.end(), by_second));
+
+        mapping moved = std::move(m);
+        FIT_TEST_CHECK(moved.size() == 100);
+        FIT_TEST_CHECK(m.empty());
+        FIT_TEST_CHECK(fit::unpack(second())(moved[99]) == 99);
+    }
+    std::remove(path);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace mapped_records_test;
+    FIT_TEST_CHECK(!fit::mapped_records<std::int32_t>("mapped_records_missing.bin").ok());
+
+    // A file that doesn't hold a whole number of records is not mapped
+    const char * path = "mapped_records_partial.bin";
+    std::FILE * f = std::fopen(path, "wb");
+    put(f, std::int32_t(1));
+    put(f, std::int16_t(2));
+    std::fclose(f);
+    auto m = fit::mapped_records<std::int32_t>(std::string(path));
+    FIT_TEST_CHECK(!m.ok());
+    FIT_TEST_CHECK(m.empty());
+    auto n = fit::mapped_records<std::int16_t>(std::string(path));
+    FIT_TEST_CHECK(n.ok());
+    FIT_TEST_CHECK(n.size() == 3);
+    std::remove(path);
+
+    // An empty file has no records
+    f = std::fopen(path, "wb");
+    std::fclose(f);
+    auto e = fit::mapped_records<std::int32_t>(path);
+    FIT_TEST_CHECK(e.ok());
+    FIT_TEST_CHECK(e.empty());
+    FIT_TEST_CHECK(e.begin() == e.end());
+    std::remove(path);
+}
@@ -0,0 +1,147 @@
+#include <fit/member.hpp>
+#include <fit/by.hpp>
+#include <fit/compress.hpp>
+#include <fit/unpack.hpp>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include "test.hpp"
+
+namespace member_test {
+
+struct foo
+{
+    int x;
+    int y;
+
+    constexpr int get_x() const
+    {
+        return x;
+    }
+
+    constexpr int add(int i) const
+    {
+        return x + i;
+    }
+
+    int& ref_y()
+    {
+        return y;
+    }
+};
+
+struct derived : foo
+{
+    constexpr derived(int i) : foo{i, i}
+    {}
+};
+
+struct sum_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+struct less_f
+{
+    template<class T, class U>
+    constexpr bool operator()(T x, U y) const
+    {
+        return x < y;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace member_test;
+    foo f = {1, 2};
+    FIT_TEST_CHECK(FIT_MEMBER(&foo::x)(f) == 1);
+    FIT_TEST_CHECK(FIT_MEMBER(&foo::y)(f) == 2);
+    FIT_TEST_CHECK(FIT_MEMBER(&foo::x)(&f) == 1);
+    FIT_TEST_CHECK(FIT_MEMBER(&foo::x)(std::ref(f)) == 1);
+    FIT_TEST_CHECK(FIT_MEMBER(&foo::x)(derived(3)) == 3);
+
+    FIT_MEMBER(&foo::x)(f) = 5;
+    FIT_TEST_CHECK(f.x == 5);
+    STATIC_ASSERT_SAME(decltype(FIT_MEMBER(&foo::x)(f)), int&);
+    STATIC_ASSERT_SAME(decltype(FIT_MEMBER(&foo::x)(static_cast<const foo&>(f))), const int&);
+    STATIC_ASSERT_SAME(decltype(FIT_MEMBER(&foo::x)(std::move(f))), int&&);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace member_test;
+    foo f = {1, 2};
+    FIT_TEST_CHECK(FIT_METHOD(&foo::get_x)(f) == 1);
+    FIT_TEST_CHECK(FIT_METHOD(&foo::get_x)(&f) == 1);
+    FIT_TEST_CHECK(FIT_METHOD(&foo::add)(f, 2) == 3);
+    FIT_TEST_CHECK(FIT_METHOD(&foo::add)(std::ref(f), 3) == 4);
+    FIT_METHOD(&foo::ref_y)(f) = 7;
+    FIT_TEST_CHECK(f.y == 7);
+
+    std::unique_ptr<foo> p(new foo{4, 5});
+    FIT_TEST_CHECK(FIT_METHOD(&foo::get_x)(p) == 4);
+    FIT_TEST_CHECK(FIT_MEMBER(&foo::y)(p) == 5);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace member_test;
+    FIT_TEST_CHECK(fit::is_callable<decltype(FIT_MEMBER(&foo::x)), foo>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(FIT_MEMBER(&foo::x)), int>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(FIT_MEMBER(&foo::x)), foo, int>::value);
+    FIT_TEST_CHECK(fit::is_callable<decltype(FIT_METHOD(&foo::add)), foo, int>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(FIT_METHOD(&foo::add)), foo>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace member_test;
+    // The projections are empty, so the adaptors stay empty, unlike with a
+    // stored member pointer
+    auto by_member = fit::by(FIT_MEMBER(&foo::x), less_f());
+    auto by_pointer = fit::by(&foo::x, less_f());
+    STATIC_ASSERT_EMPTY(FIT_MEMBER(&foo::x));
+    STATIC_ASSERT_EMPTY(FIT_METHOD(&foo::get_x));
+    STATIC_ASSERT_EMPTY(by_member);
+    STATIC_ASSERT_EMPTY(fit::by(FIT_METHOD(&foo::get_x), less_f()));
+    STATIC_ASSERT_EMPTY(fit::by(FIT_MEMBER(&foo::x), fit::compress(sum_f())));
+    STATIC_ASSERT_EMPTY(fit::unpack(fit::by(FIT_MEMBER(&foo::x), sum_f())));
+    FIT_TEST_CHECK(sizeof(by_member) < sizeof(by_pointer));
+
+    foo a = {1, 9};
+    foo b = {2, 0};
+    FIT_TEST_CHECK(by_member(a, b));
+    FIT_TEST_CHECK(!by_member(b, a));
+    FIT_TEST_CHECK(fit::by(FIT_METHOD(&foo::get_x), less_f())(a, b));
+    FIT_TEST_CHECK(fit::by(FIT_MEMBER(&foo::y), fit::compress(sum_f()))(a, b, a) == 18);
+    FIT_TEST_CHECK(fit::unpack(fit::by(FIT_MEMBER(&foo::x), sum_f()))(std::make_tuple(a, b)) == 3);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace member_test;
+    // Everything can be evaluated at compile time
+    FIT_STATIC_TEST_CHECK(FIT_MEMBER(&foo::x)(foo{1, 2}) == 1);
+    FIT_STATIC_TEST_CHECK(FIT_METHOD(&foo::add)(foo{1, 2}, 3) == 4);
+    FIT_STATIC_TEST_CHECK(fit::by(FIT_MEMBER(&foo::x), less_f())(foo{1, 2}, foo{2, 1}));
+    FIT_STATIC_TEST_CHECK(fit::by(FIT_METHOD(&foo::get_x), fit::compress(sum_f()))(foo{1, 0}, foo{2, 0}, foo{3, 0}) == 6);
+}
+
+#if FIT_HAS_TEMPLATE_AUTO && FIT_HAS_VARIABLE_TEMPLATES
+FIT_TEST_CASE()
+{
+    using namespace member_test;
+    foo f = {1, 2};
+    FIT_TEST_CHECK(fit::member<&foo::x>(f) == 1);
+    FIT_TEST_CHECK(fit::method<&foo::add>(f, 1) == 2);
+    STATIC_ASSERT_EMPTY(fit::by(fit::member<&foo::y>, less_f()));
+    FIT_STATIC_TEST_CHECK(fit::by(fit::method<&foo::get_x>, less_f())(foo{1, 2}, foo{2, 1}));
+    FIT_STATIC_TEST_CHECK(fit::unpack(fit::by(fit::member<&foo::y>, sum_f()))(std::make_tuple(foo{1, 2}, foo{2, 1})) == 3);
+}
+#endif
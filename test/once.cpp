@@ -0,0 +1,159 @@
+#include <fit/once.hpp>
+#include <fit/apply_eval.hpp>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "test.hpp"
+
+namespace once_test {
+
+struct counter
+{
+    int * count;
+    std::string operator()() const
+    {
+        ++*count;
+        return "hello";
+    }
+};
+
+struct atomic_counter
+{
+    std::atomic<int> * count;
+    std::vector<int> operator()() const
+    {
+        ++*count;
+        return std::vector<int>(1024, 1);
+    }
+};
+
+struct thrower
+{
+    int * count;
+    int operator()() const
+    {
+        if (++*count == 1) throw 1;
+        return *count;
+    }
+};
+
+struct mover
+{
+    int * count;
+    std::string&& operator()() const
+    {
+        static std::string s;
+        ++*count;
+        s = "hello";
+        return std::move(s);
+    }
+};
+
+struct id_counter
+{
+    int * count;
+    template<class Id>
+    int operator()(Id) const
+    {
+        ++*count;
+        return 1;
+    }
+};
+
+struct sum_f
+{
+    template<class T, class U>
+    T operator()(T x, U y) const
+    {
+        return x+y;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    int count = 0;
+    auto f = fit::once(once_test::counter{&count});
+    FIT_TEST_CHECK(count == 0);
+    FIT_TEST_CHECK(f() == "hello");
+    FIT_TEST_CHECK(f() == "hello");
+    FIT_TEST_CHECK(count == 1);
+    FIT_TEST_CHECK(&f() == &f());
+    static_assert(std::is_same<decltype(f()), const std::string&>::value, "Not a reference");
+    // Copies share the result
+    auto g = f;
+    FIT_TEST_CHECK(&g() == &f());
+    FIT_TEST_CHECK(count == 1);
+}
+
+FIT_TEST_CASE()
+{
+    int i = 3;
+    auto f = fit::once([&]() -> int& { return i; });
+    FIT_TEST_CHECK(&f() == &i);
+    int count = 0;
+    auto g = fit::once([&] { count++; });
+    g();
+    g();
+    FIT_TEST_CHECK(count == 1);
+}
+
+FIT_TEST_CASE()
+{
+    // An rvalue reference is moved into the cached result
+    int count = 0;
+    auto f = fit::once(once_test::mover{&count});
+    static_assert(std::is_same<decltype(f()), const std::string&>::value, "Not a const reference");
+    FIT_TEST_CHECK(f() == "hello");
+    FIT_TEST_CHECK(&f() == &f());
+    FIT_TEST_CHECK(count == 1);
+}
+
+FIT_TEST_CASE()
+{
+    int count = 0;
+    auto f = fit::once(once_test::thrower{&count});
+    bool thrown = false;
+    try
+    {
+        f();
+    }
+    catch(int)
+    {
+        thrown = true;
+    }
+    FIT_TEST_CHECK(thrown);
+    FIT_TEST_CHECK(f() == 2);
+    FIT_TEST_CHECK(f() == 2);
+    FIT_TEST_CHECK(count == 2);
+}
+
+FIT_TEST_CASE()
+{
+    std::atomic<int> count(0);
+    auto f = fit::once(once_test::atomic_counter{&count});
+    std::vector<std::thread> threads;
+    std::vector<const std::vector<int>*> results(8);
+    for(int i=0;i<8;i++) threads.emplace_back([&, i] { results[i] = &f(); });
+    for(auto& t:threads) t.join();
+    FIT_TEST_CHECK(count == 1);
+    for(auto r:results) FIT_TEST_CHECK(r == &f());
+    FIT_TEST_CHECK(f().size() == 1024);
+}
+
+FIT_TEST_CASE()
+{
+    int count = 0;
+    auto f = fit::lazy_value(once_test::counter{&count});
+    FIT_TEST_CHECK(fit::eval(f) == "hello");
+    FIT_TEST_CHECK(fit::eval(f) == "hello");
+    FIT_TEST_CHECK(count == 1);
+    auto one = fit::lazy_value(once_test::id_counter{&count});
+    FIT_TEST_CHECK(fit::apply_eval(once_test::sum_f(), one, [] { return 2; }) == 3);
+    FIT_TEST_CHECK(fit::apply_eval(once_test::sum_f(), one, one) == 2);
+    FIT_TEST_CHECK(count == 2);
+}
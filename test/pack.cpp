@@ -336,3 +336,53 @@ FIT_TEST_CASE()
 }
 
 
+
+struct pack_order_check
+{
+    template<class T, class U, class V, class W>
+    constexpr bool operator()(T a, U b, V c, W d) const
+    {
+        return a == 'a' && b == 1.5 && c == 'b' && d == 2.5;
+    }
+};
+
+struct sorted_char_double
+{
+    double b;
+    double d;
+    char a;
+    char c;
+};
+
+struct sorted_char_int
+{
+    int b;
+    char a;
+    char c;
+};
+
+FIT_TEST_CASE()
+{
+    // Elements keep their order, whatever order they are stored in
+    FIT_STATIC_TEST_CHECK(fit::pack('a', 1.5, 'b', 2.5)(pack_order_check()));
+    FIT_TEST_CHECK(fit::pack('a', 1.5, 'b', 2.5)(pack_order_check()));
+    FIT_TEST_CHECK(fit::pack_join(fit::pack('a', 1.5), fit::pack('b', 2.5))(pack_order_check()));
+    FIT_TEST_CHECK(fit::pack_join(fit::pack('a'), fit::pack(1.5, 'b', 2.5))(pack_order_check()));
+    char a = 'a';
+    double d = 2.5;
+    FIT_TEST_CHECK(fit::pack_forward(a, 1.5, 'b', d)(pack_order_check()));
+    FIT_TEST_CHECK(fit::pack(a, 1.5, 'b', d)(pack_order_check()));
+    FIT_TEST_CHECK(fit::pack('a', fit::pack(), 1.5)(fit::always(true)));
+}
+
+#if !((defined(__GNUC__) && !defined (__clang__) && __GNUC__ == 4 && __GNUC_MINOR__ < 7) || defined(_MSC_VER))
+FIT_TEST_CASE()
+{
+    // Elements are stored from the largest alignment to the smallest
+    static_assert(sizeof(fit::pack('a', 1.5, 'b', 2.5)) == sizeof(sorted_char_double), "Pack is padded");
+    static_assert(sizeof(fit::pack('a', 1, 'b')) == sizeof(sorted_char_int), "Pack is padded");
+    static_assert(sizeof(fit::pack(1.5, 'a', 2.5, 'b')) == sizeof(sorted_char_double), "Pack is padded");
+    static_assert(sizeof(fit::pack(1, 2)) == 2*sizeof(int), "Pack is padded");
+    static_assert(sizeof(fit::pack('a', fit::pack('b', 1.5), 'c')) == sizeof(fit::pack('b', 1.5)) + sizeof(double), "Pack is padded");
+}
+#endif
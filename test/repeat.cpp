@@ -1,4 +1,5 @@
 #include <fit/repeat.hpp>
+#include <utility>
 #include "test.hpp"
 
 
@@ -22,3 +23,61 @@ FIT_TEST_CASE()
     FIT_TEST_CHECK(fit::repeat(5)(increment())(1) == 6);
     FIT_STATIC_TEST_CHECK(fit::repeat(5)(increment())(1) == 6);
 }
+
+FIT_TEST_CASE()
+{
+    // Large counts are unrolled in blocks
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 8>())(increment())(1) == 9);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 9>())(increment())(1) == 10);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 17>())(increment())(1) == 18);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 1001>())(increment())(1) == 1002);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 5000>())(increment())(0) == 5000);
+    FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 17>())(increment())(1) == 18);
+    FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 5000>())(increment())(0) == 5000);
+}
+
+struct widen
+{
+    constexpr long operator()(int x) const
+    {
+        return x + 1;
+    }
+
+    constexpr long operator()(long x) const
+    {
+        return x + 2;
+    }
+};
+
+struct add
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x + y;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    // Only the first call can change the type, or take more arguments
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 20>())(widen())(0) == 39);
+    FIT_STATIC_TEST_CHECK(fit::repeat(std::integral_constant<int, 20>())(widen())(0) == 39);
+    FIT_TEST_CHECK(fit::repeat(std::integral_constant<int, 1>())(add())(1, 2) == 3);
+}
+
+struct wrap
+{
+    template<class T>
+    constexpr std::pair<T, int> operator()(T x) const
+    {
+        return std::pair<T, int>(x, 0);
+    }
+};
+
+FIT_TEST_CASE()
+{
+    // Functions that change the type are still unrolled one call at a time
+    auto r = fit::repeat(std::integral_constant<int, 10>())(wrap())(1);
+    FIT_TEST_CHECK(r.first.first.first.first.first.first.first.first.first.first == 1);
+}
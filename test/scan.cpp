@@ -0,0 +1,177 @@
+#include <fit/scan.hpp>
+#include <fit/compress.hpp>
+#include <fit/unpack.hpp>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <string>
+#include <tuple>
+#include <vector>
+#include "test.hpp"
+
+namespace scan_test {
+
+struct sum
+{
+    template<class T, class U>
+    constexpr auto operator()(T x, U y) const FIT_RETURNS(x + y);
+};
+
+struct max_f
+{
+    template<class T, class U>
+    constexpr T operator()(T x, U y) const
+    {
+        return x > y ? x : y;
+    }
+};
+
+struct as_tuple
+{
+    template<class... Ts>
+    constexpr std::tuple<Ts...> operator()(Ts... xs) const
+    {
+        return std::tuple<Ts...>(xs...);
+    }
+};
+
+struct counter
+{
+    int * count;
+    template<class T>
+    T operator()(T x, T y) const
+    {
+        ++*count;
+        return x + y;
+    }
+};
+
+struct unary_int
+{
+    int operator()(int x) const
+    {
+        return x;
+    }
+};
+
+template<class T>
+void check_range_add(std::size_t n)
+{
+    std::vector<T> v(n);
+    for(std::size_t i=0;i<n;i++) v[i] = T(i % 7 + 1);
+    std::vector<T> expected(n);
+    T state = T(3);
+    for(std::size_t i=0;i<n;i++)
+    {
+        state = state + v[i];
+        expected[i] = state;
+    }
+    std::vector<T> out(n);
+    T * last = fit::scan_range(fit::operators::add(), T(3))(v, out.data());
+    FIT_TEST_CHECK(last == out.data() + n);
+    FIT_TEST_CHECK(out == expected);
+    // Scan in place
+    fit::scan_range(std::plus<T>(), T(3))(v, v.data());
+    FIT_TEST_CHECK(v == expected);
+}
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    FIT_TEST_CHECK(fit::scan(sum(), 0)(1, 2, 3, 4)(as_tuple()) == std::make_tuple(1, 3, 6, 10));
+    FIT_TEST_CHECK(fit::scan(max_f(), 0)(2, 5, 3, 7)(as_tuple()) == std::make_tuple(2, 5, 5, 7));
+    FIT_TEST_CHECK(fit::scan(sum(), 0)(5)(as_tuple()) == std::make_tuple(5));
+    FIT_TEST_CHECK(fit::scan(sum(), 0)()(as_tuple()) == std::make_tuple());
+    FIT_TEST_CHECK(fit::scan(sum(), std::string("a"))("b", "c")(as_tuple()) == std::make_tuple(std::string("ab"), std::string("abc")));
+
+    FIT_STATIC_TEST_CHECK(fit::scan(sum(), 0)(1, 2, 3, 4)(as_tuple()) == std::make_tuple(1, 3, 6, 10));
+    FIT_STATIC_TEST_CHECK(fit::scan(max_f(), 0)(2, 5, 3, 7)(as_tuple()) == std::make_tuple(2, 5, 5, 7));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    // Every state has the type of the initial state
+    STATIC_ASSERT_SAME(decltype(fit::scan(sum(), 0)(1, 2.5, 'a')(as_tuple())), std::tuple<int, int, int>);
+    STATIC_ASSERT_SAME(decltype(fit::scan(sum(), 0.0)(1, 2)(as_tuple())), std::tuple<double, double>);
+    FIT_TEST_CHECK(fit::scan(sum(), 0)(1, 2.5, 1)(as_tuple()) == std::make_tuple(1, 3, 4));
+    STATIC_ASSERT_EMPTY(fit::scan(sum(), std::integral_constant<int, 0>()));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    // The last state is the same as compress
+    FIT_TEST_CHECK(std::get<3>(fit::scan(sum(), 1)(1, 2, 3, 4)(as_tuple())) == fit::compress(sum(), 1)(1, 2, 3, 4));
+    FIT_TEST_CHECK(fit::unpack(fit::scan(sum(), 0))(std::make_tuple(1, 2, 3))(as_tuple()) == std::make_tuple(1, 3, 6));
+    FIT_STATIC_TEST_CHECK(fit::unpack(fit::scan(sum(), 0))(std::make_tuple(1, 2, 3))(as_tuple()) == std::make_tuple(1, 3, 6));
+    // The result is a pack, so it can be unpacked
+    FIT_TEST_CHECK(fit::unpack(fit::compress(sum(), 0))(fit::scan(sum(), 0)(1, 2, 3)) == 10);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    // The function is called once for each argument
+    int count = 0;
+    fit::scan(counter{&count}, 0)(1, 2, 3, 4, 5, 6, 7, 8);
+    FIT_TEST_CHECK(count == 8);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    FIT_TEST_CHECK(fit::is_callable<decltype(fit::scan(sum(), 0)), int, int>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(fit::scan(sum(), 0)), int, std::string>::value);
+    FIT_TEST_CHECK(!fit::is_callable<decltype(fit::scan(unary_int(), 0)), int>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    std::list<int> l = { 1, 2, 3, 4 };
+    std::vector<int> out;
+    fit::scan_range(sum(), 0)(l, std::back_inserter(out));
+    FIT_TEST_CHECK(out == std::vector<int>({ 1, 3, 6, 10 }));
+
+    std::vector<std::string> words = { "a", "b", "c" };
+    std::vector<std::string> prefixes(3);
+    auto last = fit::scan_range(sum(), std::string())(words, prefixes.begin());
+    FIT_TEST_CHECK(last == prefixes.end());
+    FIT_TEST_CHECK(prefixes == std::vector<std::string>({ "a", "ab", "abc" }));
+
+    int a[] = { 3, 1, 4, 1, 5 };
+    int r[5];
+    fit::scan_range(max_f(), 0)(a, r);
+    FIT_TEST_CHECK(r[0] == 3 && r[1] == 3 && r[2] == 4 && r[3] == 4 && r[4] == 5);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    // Sizes around the vector width, including the scalar tail
+    for(std::size_t n=0;n<40;n++)
+    {
+        check_range_add<float>(n);
+        check_range_add<double>(n);
+        check_range_add<int>(n);
+        check_range_add<unsigned>(n);
+        check_range_add<std::int64_t>(n);
+        check_range_add<short>(n);
+    }
+    check_range_add<float>(1000);
+    check_range_add<std::int64_t>(1001);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace scan_test;
+    // The state has a different type than the elements
+    std::vector<float> v = { 0.5f, 0.5f, 0.5f };
+    std::vector<double> out(3);
+    fit::scan_range(fit::operators::add(), 0.0)(v, out.begin());
+    FIT_TEST_CHECK(out == std::vector<double>({ 0.5, 1.0, 1.5 }));
+}
@@ -0,0 +1,340 @@
+#include <fit/serialize.hpp>
+#include <fit/pack.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <string>
+#if FIT_HAS_STRING_VIEW
+#include <string_view>
+#endif
+#include <tuple>
+#include <vector>
+#include "test.hpp"
+
+namespace serialize_test {
+
+struct point
+{
+    int x;
+    int y;
+};
+
+// Has padding after c, so it's written field by field
+struct record
+{
+    char c;
+    int i;
+    double d;
+};
+
+// Fields are in the same order as in memory, so it's copied at once
+struct flat_record
+{
+    int i;
+    float f;
+};
+
+struct named
+{
+    std::string name;
+    std::vector<int> values;
+
+    named(std::string n, std::vector<int> v) : name(std::move(n)), values(std::move(v))
+    {}
+};
+
+enum class color : short
+{
+    red,
+    green
+};
+
+// A view without padding that holds a pointer, like std::string_view
+struct view
+{
+    const char * p;
+    std::size_t n;
+
+    const char * data() const
+    {
+        return p;
+    }
+
+    std::size_t size() const
+    {
+        return n;
+    }
+
+    const char * begin() const
+    {
+        return p;
+    }
+
+    const char * end() const
+    {
+        return p + n;
+    }
+};
+
+}
+
+namespace fit {
+
+template<>
+struct unpack_sequence<serialize_test::record>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        f(s.c, s.i, s.d)
+    );
+};
+
+template<>
+struct unpack_sequence<serialize_test::flat_record>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        f(s.i, s.f)
+    );
+};
+
+template<>
+struct unpack_sequence<serialize_test::named>
+{
+    template<class F, class S>
+    constexpr static auto apply(F&& f, S&& s) FIT_RETURNS
+    (
+        f(s.name, s.values)
+    );
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    FIT_TEST_CHECK(fit::serialized_size(1, 'a', 2.0) == sizeof(int) + 1 + sizeof(double));
+    FIT_TEST_CHECK(fit::serialized_size(std::make_tuple(1, short(2))) == sizeof(int) + sizeof(short));
+    FIT_TEST_CHECK(fit::serialized_size(std::string("abc")) == 8 + 3);
+    FIT_TEST_CHECK(fit::serialized_size(std::vector<int>(4)) == 8 + 4*sizeof(int));
+    FIT_TEST_CHECK(fit::serialized_size(record{'a', 1, 2.0}) == 1 + sizeof(int) + sizeof(double));
+    FIT_TEST_CHECK(fit::serialized_size(std::make_tuple(1, std::integral_constant<int, 5>())) == sizeof(int));
+
+    FIT_STATIC_TEST_CHECK(fit::detail::serialize_fixed<record>::value);
+    FIT_STATIC_TEST_CHECK(fit::detail::serialize_fixed<std::tuple<int, color, record>>::value);
+    FIT_STATIC_TEST_CHECK(!fit::detail::serialize_fixed<std::tuple<int, std::string>>::value);
+    FIT_STATIC_TEST_CHECK(!fit::is_callable<fit::detail::serialized_size_f, int*>::value);
+    FIT_STATIC_TEST_CHECK(!fit::is_callable<fit::detail::serialized_size_f, std::tuple<int, int*>>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    std::vector<char> buffer(256);
+    auto w = fit::serialize(buffer);
+    FIT_TEST_CHECK(w(1, color::green, 2.5f));
+    FIT_TEST_CHECK(w(std::make_tuple(std::string("hello"), 7)));
+    FIT_TEST_CHECK(w(fit::pack(short(3), std::vector<double>{ 1.0, 2.0 })));
+    FIT_TEST_CHECK(w.size() == fit::serialized_size(1, color::green, 2.5f,
+        std::make_tuple(std::string("hello"), 7),
+        fit::pack(short(3), std::vector<double>{ 1.0, 2.0 })));
+
+    fit::byte_reader r(buffer);
+    FIT_TEST_CHECK(fit::deserialize<int>(r) == 1);
+    FIT_TEST_CHECK(fit::deserialize<color>(r) == color::green);
+    FIT_TEST_CHECK(fit::deserialize<float>(r) == 2.5f);
+    auto t = fit::deserialize<std::tuple<std::string, int>>(r);
+    FIT_TEST_CHECK(std::get<0>(t) == "hello");
+    FIT_TEST_CHECK(std::get<1>(t) == 7);
+    auto p = fit::deserialize<std::tuple<short, std::vector<double>>>(r);
+    FIT_TEST_CHECK(std::get<0>(p) == 3);
+    FIT_TEST_CHECK(std::get<1>(p) == std::vector<double>({ 1.0, 2.0 }));
+    FIT_TEST_CHECK(r.ok());
+    FIT_TEST_CHECK(r.remaining() == buffer.size() - w.size());
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // Aggregates and constructors are rebuilt from their fields
+    char buffer[128];
+    auto w = fit::serialize(buffer);
+    FIT_TEST_CHECK(w(record{'x', 2, 3.5}, flat_record{4, 5.5f}));
+    FIT_TEST_CHECK(w(named("n", { 1, 2, 3 })));
+    FIT_TEST_CHECK(w(std::list<std::string>{ "a", "bc" }));
+
+    fit::byte_reader r(buffer);
+    record a = fit::deserialize<record>(r);
+    FIT_TEST_CHECK(a.c == 'x');
+    FIT_TEST_CHECK(a.i == 2);
+    FIT_TEST_CHECK(a.d == 3.5);
+    flat_record b = fit::deserialize<flat_record>(r);
+    FIT_TEST_CHECK(b.i == 4);
+    FIT_TEST_CHECK(b.f == 5.5f);
+    named n = fit::deserialize<named>(r);
+    FIT_TEST_CHECK(n.name == "n");
+    FIT_TEST_CHECK(n.values == std::vector<int>({ 1, 2, 3 }));
+    auto l = fit::deserialize<std::list<std::string>>(r);
+    FIT_TEST_CHECK(l == std::list<std::string>({ "a", "bc" }));
+    FIT_TEST_CHECK(r.ok());
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // The fields of a flat record follow each other in memory
+    flat_record f = { 1, 2.0f };
+    FIT_TEST_CHECK(fit::detail::serialize_flat(f));
+    record g = { 'a', 1, 2.0 };
+    FIT_TEST_CHECK(!fit::detail::serialize_flat(g));
+    FIT_TEST_CHECK(!fit::detail::serialize_flat(std::make_tuple(1, 2)) || sizeof(std::tuple<int, int>) == 2*sizeof(int));
+
+    std::array<unsigned char, 16> buffer;
+    auto w = fit::serialize(buffer);
+    FIT_TEST_CHECK(w(f));
+    FIT_TEST_CHECK(w.size() == sizeof(flat_record));
+    unsigned char expected[sizeof(flat_record)];
+    std::memcpy(expected, &f, sizeof(f));
+    FIT_TEST_CHECK(std::memcmp(buffer.data(), expected, sizeof(f)) == 0);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // Nothing is written when the values don't fit
+    char buffer[10];
+    auto w = fit::serialize(buffer);
+    FIT_TEST_CHECK(w(1, 2));
+    FIT_TEST_CHECK(!w(std::string("abc")));
+    FIT_TEST_CHECK(w.size() == 2*sizeof(int));
+    FIT_TEST_CHECK(w('a', 'b'));
+    FIT_TEST_CHECK(!w('c'));
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // Reading past the end fails and reads zeros
+    std::vector<char> buffer(sizeof(int) + 2);
+    fit::serialize(buffer)(42);
+    fit::byte_reader r(buffer);
+    FIT_TEST_CHECK(fit::deserialize<int>(r) == 42);
+    FIT_TEST_CHECK(fit::deserialize<int>(r) == 0);
+    FIT_TEST_CHECK(!r.ok());
+
+    // A size larger than the rest of the buffer doesn't allocate
+    std::vector<char> bad(16);
+    std::uint64_t huge = std::uint64_t(1) << 60;
+    std::memcpy(bad.data(), &huge, sizeof(huge));
+    fit::byte_reader br(bad);
+    FIT_TEST_CHECK(fit::deserialize<std::vector<int>>(br).empty());
+    FIT_TEST_CHECK(!br.ok());
+    fit::byte_reader lr(bad);
+    FIT_TEST_CHECK(fit::deserialize<std::list<std::string>>(lr).empty());
+    FIT_TEST_CHECK(!lr.ok());
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    fit::byte_ring<32> ring;
+    auto w = fit::serialize(ring);
+    FIT_TEST_CHECK(ring.empty());
+    // Each record is 12 bytes, so they wrap around the ring
+    for(int i=0;i<20;i++)
+    {
+        FIT_TEST_CHECK(w(std::make_tuple(i, i * 0.5)));
+        if (i % 2 == 1)
+        {
+            auto t = fit::deserialize<std::tuple<int, double>>(ring);
+            FIT_TEST_CHECK(std::get<0>(t) == i - 1);
+            auto u = fit::deserialize<std::tuple<int, double>>(ring);
+            FIT_TEST_CHECK(std::get<0>(u) == i);
+            FIT_TEST_CHECK(std::get<1>(u) == i * 0.5);
+        }
+    }
+    FIT_TEST_CHECK(ring.empty());
+
+    FIT_TEST_CHECK(w(std::string("abcdef")));
+    FIT_TEST_CHECK(w(std::string("ghijkl")));
+    FIT_TEST_CHECK(!w(std::string("mnopqr")));
+    FIT_TEST_CHECK(fit::deserialize<std::string>(ring) == "abcdef");
+    FIT_TEST_CHECK(w(std::string("mnopqr")));
+    FIT_TEST_CHECK(fit::deserialize<std::string>(ring) == "ghijkl");
+    FIT_TEST_CHECK(fit::deserialize<std::string>(ring) == "mnopqr");
+    FIT_TEST_CHECK(ring.empty());
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // A record that fails to be read is left in the ring
+    fit::byte_ring<16> ring;
+    auto w = fit::serialize(ring);
+    FIT_TEST_CHECK(w(short(5)));
+    fit::deserialize<int>(ring);
+    FIT_TEST_CHECK(ring.size() == sizeof(short));
+    FIT_TEST_CHECK(fit::deserialize<short>(ring) == 5);
+    FIT_TEST_CHECK(ring.empty());
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // A failed read is reported, and a later read of the whole record works
+    fit::byte_ring<16> ring;
+    auto w = fit::serialize(ring);
+    bool ok = true;
+    FIT_TEST_CHECK(fit::deserialize<int>(ring, ok) == 0);
+    FIT_TEST_CHECK(!ok);
+    FIT_TEST_CHECK(w(short(5)));
+    FIT_TEST_CHECK(fit::deserialize<std::tuple<short, short>>(ring, ok) == std::make_tuple(short(5), short(0)));
+    FIT_TEST_CHECK(!ok);
+    FIT_TEST_CHECK(ring.size() == sizeof(short));
+    FIT_TEST_CHECK(fit::deserialize<short>(ring, ok) == 5);
+    FIT_TEST_CHECK(ok);
+    FIT_TEST_CHECK(ring.empty());
+}
+
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // Views are written like the range they refer to, not as a pointer
+    std::string s = "abc";
+    view v = { s.data(), s.size() };
+    FIT_STATIC_TEST_CHECK(!fit::detail::serialize_is_raw<view>::value);
+    FIT_STATIC_TEST_CHECK(fit::detail::serialize_is_raw<std::array<int, 3>>::value);
+    FIT_TEST_CHECK(fit::serialized_size(v) == fit::serialized_size(s));
+    std::vector<char> buffer(64);
+    auto w = fit::serialize(buffer);
+    FIT_TEST_CHECK(w(v, std::make_tuple(v, 1)));
+    fit::byte_reader r(buffer);
+    FIT_TEST_CHECK(fit::deserialize<std::string>(r) == "abc");
+    FIT_TEST_CHECK(fit::deserialize<std::tuple<std::string, int>>(r) == std::make_tuple(std::string("abc"), 1));
+    FIT_TEST_CHECK(r.ok());
+    // A view doesn't own its elements, so it can't be read back
+    FIT_STATIC_TEST_CHECK(!fit::is_callable<fit::detail::serialize_read_f, fit::byte_reader&, fit::detail::serialize_type<view>>::value);
+#if FIT_HAS_STRING_VIEW
+    FIT_STATIC_TEST_CHECK(!fit::detail::serialize_is_raw<std::string_view>::value);
+    FIT_TEST_CHECK(fit::serialized_size(std::string_view(s)) == 8 + 3);
+#endif
+}
+
+#if FIT_HAS_UNIQUE_OBJECT_REPRESENTATIONS
+FIT_TEST_CASE()
+{
+    using namespace serialize_test;
+    // Structs without padding are copied as they are
+    FIT_STATIC_TEST_CHECK(fit::detail::serialize_is_raw<point>::value);
+    FIT_TEST_CHECK(fit::serialized_size(std::vector<point>(3)) == 8 + 3*sizeof(point));
+    std::vector<char> buffer(64);
+    fit::serialize(buffer)(std::vector<point>{ { 1, 2 }, { 3, 4 } });
+    auto v = fit::deserialize<std::vector<point>>(buffer);
+    FIT_TEST_CHECK(v.size() == 2);
+    FIT_TEST_CHECK(v[1].x == 3);
+    FIT_TEST_CHECK(v[1].y == 4);
+}
+#endif
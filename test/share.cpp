@@ -0,0 +1,113 @@
+#include <fit/share.hpp>
+#include <fit/pack.hpp>
+#include <fit/capture.hpp>
+#include <fit/partial.hpp>
+#include <fit/pipable.hpp>
+#include <fit/unpack.hpp>
+#include <fit/flip.hpp>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+struct copy_counter
+{
+    int * copies;
+    std::vector<int> table;
+    copy_counter(int * c) : copies(c), table(1024, 1)
+    {}
+
+    copy_counter(const copy_counter& rhs) : copies(rhs.copies), table(rhs.table)
+    {
+        ++*copies;
+    }
+
+    copy_counter(copy_counter&& rhs) : copies(rhs.copies), table(std::move(rhs.table))
+    {}
+};
+
+struct lookup
+{
+    int operator()(const copy_counter& c, int i) const
+    {
+        return c.table[i] + i;
+    }
+};
+
+struct table_address
+{
+    template<class T>
+    const void * operator()(const T& x) const
+    {
+        return &x;
+    }
+};
+
+FIT_TEST_CASE()
+{
+    auto s = fit::share(std::string("hello"));
+    STATIC_ASSERT_SAME(decltype(s), fit::shared<std::string>);
+    FIT_TEST_CHECK(*s == "hello");
+    FIT_TEST_CHECK(s->size() == 5);
+    FIT_TEST_CHECK(s.use_count() == 1);
+    auto s2 = s;
+    FIT_TEST_CHECK(s.use_count() == 2);
+    FIT_TEST_CHECK(&s.get() == &s2.get());
+    {
+        auto s3 = s2;
+        FIT_TEST_CHECK(s.use_count() == 3);
+    }
+    FIT_TEST_CHECK(s.use_count() == 2);
+    auto s4 = std::move(s2);
+    FIT_TEST_CHECK(s.use_count() == 2);
+    FIT_TEST_CHECK(s2.use_count() == 0);
+    const std::string& r = s4;
+    FIT_TEST_CHECK(r == "hello");
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    auto f = fit::capture(fit::share(copy_counter(&copies)))(lookup());
+    FIT_TEST_CHECK(copies == 0);
+    auto g = f;
+    auto h = g;
+    FIT_TEST_CHECK(copies == 0);
+    FIT_TEST_CHECK(h(2) == 3);
+    FIT_TEST_CHECK(f(1) == 2);
+    FIT_TEST_CHECK(copies == 0);
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    auto f = fit::partial(lookup())(fit::share(copy_counter(&copies)));
+    auto g = f;
+    FIT_TEST_CHECK(g(2) == 3);
+    FIT_TEST_CHECK(f(1) == 2);
+    FIT_TEST_CHECK(copies == 0);
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    auto s = fit::share(copy_counter(&copies));
+    auto p = fit::pack(fit::shared<copy_counter>(s), 2);
+    auto p2 = p;
+    FIT_TEST_CHECK(s.use_count() == 3);
+    FIT_TEST_CHECK(p2(lookup()) == 3);
+    FIT_TEST_CHECK(fit::unpack(lookup())(p) == 3);
+    FIT_TEST_CHECK(fit::unpack(lookup())(fit::pack(s, 1)) == 2);
+    FIT_TEST_CHECK(fit::pack(s)(table_address()) == &s.get());
+    FIT_TEST_CHECK(fit::pack_decay(s)(table_address()) == &s.get());
+    FIT_TEST_CHECK(fit::unpack(table_address())(fit::pack_decay(s)) == &s.get());
+    FIT_TEST_CHECK(copies == 0);
+    FIT_TEST_CHECK(s.use_count() == 3);
+}
+
+FIT_TEST_CASE()
+{
+    int copies = 0;
+    auto s = fit::share(copy_counter(&copies));
+    FIT_TEST_CHECK((2 | fit::pipable(fit::flip(lookup()))(s)) == 3);
+    FIT_TEST_CHECK(copies == 0);
+}
@@ -0,0 +1,145 @@
+#include <fit/stream.hpp>
+#include <fit/placeholders.hpp>
+#include <list>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+namespace stream_test {
+
+struct square
+{
+    int operator()(int x) const
+    {
+        return x * x;
+    }
+};
+
+int twice(int x)
+{
+    return 2 * x;
+}
+
+struct counted_identity
+{
+    int * count;
+    int operator()(int x) const
+    {
+        ++*count;
+        return x;
+    }
+};
+
+struct copies
+{
+    std::vector<int> operator()(int x) const
+    {
+        return std::vector<int>(x, x);
+    }
+};
+
+// Returns a pipeline, which only takes the first two copies
+struct two_copies
+{
+    template<class T>
+    auto operator()(T x) const -> decltype(std::vector<int>() | fit::stream::take(2))
+    {
+        return std::vector<int>(x, x) | fit::stream::take(2);
+    }
+};
+
+struct append
+{
+    std::string operator()(std::string s, int x) const
+    {
+        return s + char('0' + x);
+    }
+};
+
+struct push_to
+{
+    std::vector<int> * v;
+    void operator()(int x) const
+    {
+        v->push_back(x);
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace stream_test;
+    using fit::_1;
+    using fit::_2;
+    std::vector<int> v = { 1, 2, 3, 4, 5, 6 };
+    FIT_TEST_CHECK((v | fit::stream::fold(_1 + _2, 0)) == 21);
+    FIT_TEST_CHECK((v | fit::stream::map(square()) | fit::stream::fold(_1 + _2, 0)) == 91);
+    FIT_TEST_CHECK((v | fit::stream::filter(_1 > 3) | fit::stream::map(&twice) | fit::stream::fold(_1 + _2, 0)) == 30);
+    FIT_TEST_CHECK((v | fit::stream::map(_1 * 2) | fit::stream::filter(_1 < 7) | fit::stream::fold(_1 + _2, 0)) == 12);
+    FIT_TEST_CHECK((v | fit::stream::take(2) | fit::stream::fold(append(), std::string())) == "12");
+    FIT_TEST_CHECK(fit::stream::fold(fit::stream::map(v, square()), _1 + _2, 0) == 91);
+
+    std::list<int> l(v.begin(), v.end());
+    int a[] = { 1, 2, 3 };
+    FIT_TEST_CHECK((l | fit::stream::filter(_1 != 2) | fit::stream::fold(_1 * _2, 1)) == 360);
+    FIT_TEST_CHECK((a | fit::stream::map(square()) | fit::stream::fold(_1 + _2, 0)) == 14);
+
+    std::vector<int> out;
+    v | fit::stream::filter(_1 > 4) | fit::stream::for_each(push_to{ &out });
+    FIT_TEST_CHECK(out == std::vector<int>({ 5, 6 }));
+
+    FIT_STATIC_TEST_CHECK(fit::detail::is_stream_source<std::vector<int>&>::value);
+    FIT_STATIC_TEST_CHECK(fit::detail::is_stream_source<decltype(v | fit::stream::take(1))>::value);
+    FIT_STATIC_TEST_CHECK(!fit::detail::is_stream_source<int>::value);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace stream_test;
+    using fit::_1;
+    using fit::_2;
+    std::vector<int> v = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    // Elements after the first n are never read
+    int count = 0;
+    FIT_TEST_CHECK((v | fit::stream::map(counted_identity{ &count }) | fit::stream::take(3) | fit::stream::fold(_1 + _2, 0)) == 6);
+    FIT_TEST_CHECK(count == 3);
+    count = 0;
+    FIT_TEST_CHECK((v | fit::stream::map(counted_identity{ &count }) | fit::stream::take(0) | fit::stream::fold(_1 + _2, 0)) == 0);
+    FIT_TEST_CHECK(count == 0);
+    FIT_TEST_CHECK((v | fit::stream::take(100) | fit::stream::fold(_1 + _2, 0)) == 55);
+    count = 0;
+    FIT_TEST_CHECK((v | fit::stream::map(counted_identity{ &count }) | fit::stream::filter(_1 > 5) | fit::stream::take(2) | fit::stream::fold(_1 + _2, 0)) == 13);
+    FIT_TEST_CHECK(count == 7);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace stream_test;
+    using fit::_1;
+    using fit::_2;
+    std::vector<int> v = { 1, 2, 3 };
+    FIT_TEST_CHECK((v | fit::stream::flat_map(copies()) | fit::stream::fold(append(), std::string())) == "122333");
+    FIT_TEST_CHECK((v | fit::stream::flat_map(copies()) | fit::stream::take(4) | fit::stream::fold(append(), std::string())) == "1223");
+    // A take in the inner pipeline only stops the inner loop
+    FIT_TEST_CHECK((v | fit::stream::flat_map(two_copies()) | fit::stream::fold(append(), std::string())) == "12233");
+    FIT_TEST_CHECK((v | fit::stream::flat_map(two_copies()) | fit::stream::take(4) | fit::stream::fold(append(), std::string())) == "1223");
+}
+
+FIT_TEST_CASE()
+{
+    using namespace stream_test;
+    using fit::_1;
+    using fit::_2;
+    // A pipeline over an rvalue range owns the range, and can run more than once
+    auto p = std::vector<int>{ 1, 2, 3, 4 } | fit::stream::map(square()) | fit::stream::filter(_1 > 1);
+    FIT_TEST_CHECK((p | fit::stream::fold(_1 + _2, 0)) == 29);
+    FIT_TEST_CHECK((p | fit::stream::take(1) | fit::stream::fold(_1 + _2, 0)) == 4);
+    FIT_TEST_CHECK((p | fit::stream::fold(_1 + _2, 0)) == 29);
+
+    // A pipeline over an lvalue range sees changes to it
+    std::vector<int> v = { 1, 2 };
+    auto q = v | fit::stream::map(square());
+    v.push_back(3);
+    FIT_TEST_CHECK((q | fit::stream::fold(_1 + _2, 0)) == 14);
+}
@@ -0,0 +1,151 @@
+#include <fit/string_switch.hpp>
+#include <string>
+#include <vector>
+#include "test.hpp"
+
+namespace string_switch_test {
+
+template<int N>
+struct constant
+{
+    constexpr int operator()() const
+    {
+        return N;
+    }
+
+    constexpr int operator()(int x) const
+    {
+        return N + x;
+    }
+};
+
+struct unknown
+{
+    template<class S>
+    constexpr int operator()(const S&) const
+    {
+        return -1;
+    }
+
+    template<class S>
+    constexpr int operator()(const S&, int) const
+    {
+        return -2;
+    }
+};
+
+struct name_length
+{
+    int operator()(const std::string& name) const
+    {
+        return static_cast<int>(name.size());
+    }
+};
+
+struct two_args
+{
+    int operator()(int x, int y) const
+    {
+        return x * y;
+    }
+};
+
+}
+
+FIT_TEST_CASE()
+{
+    using namespace string_switch_test;
+    auto f = fit::string_switch("get", constant<1>(), "put", constant<2>(), "delete", constant<3>(), unknown());
+    FIT_TEST_CHECK(f("get") == 1);
+    FIT_TEST_CHECK(f("put") == 2);
+    FIT_TEST_CHECK(f("delete") == 3);
+    FIT_TEST_CHECK(f("post") == -1);
+    FIT_TEST_CHECK(f("") == -1);
+    FIT_TEST_CHECK(f("gett") == -1);
+    FIT_TEST_CHECK(f(std::string("put")) == 2);
+    FIT_TEST_CHECK(f(std::string("put"), 10) == 12);
+    FIT_TEST_CHECK(f(std::string("post"), 10) == -2);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace string_switch_test;
+    // Without a fallback a default constructed result is returned
+    auto f = fit::string_switch("get", constant<1>(), "put", constant<2>());
+    FIT_TEST_CHECK(f("get") == 1);
+    FIT_TEST_CHECK(f("put") == 2);
+    FIT_TEST_CHECK(f("post") == 0);
+    FIT_TEST_CHECK(f.index("put") == 1);
+    FIT_TEST_CHECK(f.index("post") == 2);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace string_switch_test;
+    // The first key wins
+    auto f = fit::string_switch("get", constant<1>(), "get", constant<2>(), "put", constant<3>(), unknown());
+    FIT_TEST_CHECK(f("get") == 1);
+    FIT_TEST_CHECK(f("put") == 3);
+    FIT_TEST_CHECK(f.index("get") == 0);
+}
+
+FIT_TEST_CASE()
+{
+    using namespace string_switch_test;
+    // Functions that can't be called go to the fallback
+    auto f = fit::string_switch("length", name_length(), "mul", two_args(), [](const std::string&, int, int) { return 0; });
+    FIT_TEST_CHECK(f(std::string("mul"), 3, 4) == 12);
+    FIT_TEST_CHECK(f(std::string("length"), 3, 4) == 0);
+    FIT_TEST_CHECK(f(std::string("other"), 3, 4) == 0);
+}
+
+FIT_TEST_CASE()
+{
+    std::vector<std::string> calls;
+    auto f = fit::string_switch(
+        "a", [&]{ calls.push_back("a"); },
+        "b", [&]{ calls.push_back("b"); },
+        [&](const char * name) { calls.push_back(std::string("?") + name); }
+    );
+    f("a");
+    f("c");
+    f("b");
+    FIT_TEST_CHECK(calls.size() == 3);
+    FIT_TEST_CHECK(calls[0] == "a");
+    FIT_TEST_CHECK(calls[1] == "?c");
+    FIT_TEST_CHECK(calls[2] == "b");
+}
+
+#define STRING_SWITCH_KEY(n) #n, string_switch_test::constant<n>()
+#define STRING_SWITCH_KEYS8(n) STRING_SWITCH_KEY(n##0), STRING_SWITCH_KEY(n##1), STRING_SWITCH_KEY(n##2), STRING_SWITCH_KEY(n##3), \
+    STRING_SWITCH_KEY(n##4), STRING_SWITCH_KEY(n##5), STRING_SWITCH_KEY(n##6), STRING_SWITCH_KEY(n##7)
+
+FIT_TEST_CASE()
+{
+    using namespace string_switch_test;
+    auto f = fit::string_switch(
+        STRING_SWITCH_KEYS8(1), STRING_SWITCH_KEYS8(2), STRING_SWITCH_KEYS8(3), STRING_SWITCH_KEYS8(4), 
+        STRING_SWITCH_KEYS8(5), STRING_SWITCH_KEYS8(6), STRING_SWITCH_KEYS8(7), STRING_SWITCH_KEYS8(8), 
+        unknown()
+    );
+    for(int i=1;i<=8;i++) for(int j=0;j<8;j++)
+    {
+        int n = i*10 + j;
+        FIT_TEST_CHECK(f(std::to_string(n)) == n);
+    }
+    FIT_TEST_CHECK(f(std::string("90")) == -1);
+    FIT_TEST_CHECK(f(std::string("1")) == -1);
+}
+
+#if FIT_HAS_RELAXED_CONSTEXPR
+FIT_TEST_CASE()
+{
+    using namespace string_switch_test;
+    static constexpr auto f = fit::string_switch("get", constant<1>(), "put", constant<2>(), "delete", constant<3>(), unknown());
+    static_assert(f.index("get") == 0, "Wrong index");
+    static_assert(f.index("put") == 1, "Wrong index");
+    static_assert(f.index("delete") == 2, "Wrong index");
+    static_assert(f.index("post") == 3, "Wrong index");
+    FIT_TEST_CHECK(f("put") == 2);
+}
+#endif